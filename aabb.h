@@ -0,0 +1,43 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <limits>
+
+// Caja alineada a los ejes, usada por el BVH
+struct AABB {
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::infinity());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::infinity());
+
+    void expand(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    void expand(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    glm::vec3 centroid() const {
+        return (min + max) * 0.5f;
+    }
+
+    float surfaceArea() const {
+        glm::vec3 e = max - min;
+        if (e.x < 0.0f || e.y < 0.0f || e.z < 0.0f) {
+            return 0.0f;
+        }
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    // Prueba de slabs; devuelve la distancia de entrada o infinito si no hay corte en [0, tMax]
+    float rayEntry(const glm::vec3& rayOrigin, const glm::vec3& invDir, float tMax) const {
+        glm::vec3 t0 = (min - rayOrigin) * invDir;
+        glm::vec3 t1 = (max - rayOrigin) * invDir;
+        glm::vec3 tSmall = glm::min(t0, t1);
+        glm::vec3 tBig = glm::max(t0, t1);
+        float tNear = glm::max(glm::max(tSmall.x, tSmall.y), glm::max(tSmall.z, 0.0f));
+        float tFar = glm::min(glm::min(tBig.x, tBig.y), glm::min(tBig.z, tMax));
+        return tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+    }
+};
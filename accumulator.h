@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include "glm/glm.hpp"
+#include "color.h"
+
+// Suma en float de las muestras de cada pixel para el refinamiento progresivo.
+// rgb suma el color de las muestras que golpearon algo y a cuenta cuantas fueron;
+// el resto de las muestras dejan ver el fondo, asi los bordes quedan suavizados.
+class Accumulator {
+public:
+    Accumulator(int width, int height) : width(width), height(height), sums(static_cast<size_t>(width) * height) {}
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Pases empezados desde el ultimo reset(); el siguiente pase es la muestra numero getSampleCount()
+    int getSampleCount() const { return sampleCount; }
+    void reset() { sampleCount = 0; }
+    // Lo llama el hilo que lanza el pase, antes de repartir los tiles
+    int beginSample() { return sampleCount++; }
+
+    // Agrega la muestra 'sample' del pixel y devuelve el promedio. La muestra 0 reemplaza lo
+    // acumulado. Cada pixel lo escribe un solo hilo por pase.
+    Color add(int x, int y, int sample, const Color& color, bool hit) {
+        glm::vec4& sum = sums[static_cast<size_t>(y) * width + x];
+        glm::vec4 value = hit ? glm::vec4(color.r, color.g, color.b, 1.0f) : glm::vec4(0.0f);
+        sum = sample == 0 ? value : sum + value;
+        if (sum.a == 0.0f) {
+            return Color(0, 0, 0, 0);
+        }
+        return Color(static_cast<int>(sum.r / sum.a + 0.5f), static_cast<int>(sum.g / sum.a + 0.5f),
+                     static_cast<int>(sum.b / sum.a + 0.5f), static_cast<int>(sum.a / (sample + 1) * 255.0f + 0.5f));
+    }
+
+private:
+    int width;
+    int height;
+    int sampleCount = 0;
+    std::vector<glm::vec4> sums;
+};
@@ -0,0 +1,10 @@
+#include "background.h"
+
+bool Background::load(const std::string& file, ImageDecoder decoder) {
+    ImageData decoded;
+    if (decoder == nullptr || !decoder(file, decoded)) {
+        return false;
+    }
+    image = std::move(decoded);
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include "color.h"
+#include "image.h"
+
+// Fondo de la escena. La imagen se decodifica una sola vez a RGBA8; el visor la sube
+// a una textura y el render sin ventana la usa como busqueda de entorno.
+class Background {
+public:
+    bool load(const std::string& file, ImageDecoder decoder);
+    bool isLoaded() const { return image.width > 0; }
+    const ImageData& getImage() const { return image; }
+
+    // Busqueda de entorno para rayos que no golpean nada; u, v en [0, 1] sobre la pantalla
+    Color sample(float u, float v) const {
+        if (image.width == 0) {
+            return Color(0, 0, 0);
+        }
+        int x = std::clamp(static_cast<int>(u * image.width), 0, image.width - 1);
+        int y = std::clamp(static_cast<int>(v * image.height), 0, image.height - 1);
+        const uint8_t* p = &image.rgba[(static_cast<size_t>(y) * image.width + x) * 4];
+        return Color(p[0], p[1], p[2], p[3]);
+    }
+
+private:
+    ImageData image;
+};
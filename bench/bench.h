@@ -0,0 +1,147 @@
+#pragma once
+
+// Arnes minimo al estilo de Google Benchmark, sin dependencias:
+//
+//   void BM_Algo(bench::State& state) {
+//       for ([[maybe_unused]] auto _ : state) { ... }
+//       state.setItemsProcessed(state.iterations() * raysPorIteracion);
+//   }
+//   BENCHMARK(BM_Algo);
+//
+// Cada benchmark se repite hasta superar un tiempo minimo y se reporta en ns/op y,
+// si declara items procesados, en Mrays/s.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    class State {
+    public:
+        explicit State(uint64_t iterations) : maxIterations(iterations) {}
+
+        // El for por rango evalua begin() y end() antes de la primera vuelta;
+        // el tiempo se detiene cuando el iterador llega al final
+        struct Iterator {
+            State* state;
+            uint64_t remaining;
+            bool operator!=(const Iterator&) {
+                if (remaining != 0) {
+                    return true;
+                }
+                state->stop = std::chrono::steady_clock::now();
+                return false;
+            }
+            void operator++() { --remaining; }
+            int operator*() const { return 0; }
+        };
+
+        Iterator begin() {
+            start = std::chrono::steady_clock::now();
+            return Iterator{this, maxIterations};
+        }
+
+        Iterator end() { return Iterator{this, 0}; }
+
+        uint64_t iterations() const { return maxIterations; }
+        void setItemsProcessed(uint64_t items) { itemsProcessed = items; }
+        uint64_t getItemsProcessed() const { return itemsProcessed; }
+
+        double elapsedSeconds() const {
+            return std::chrono::duration<double>(stop - start).count();
+        }
+
+    private:
+        uint64_t maxIterations;
+        uint64_t itemsProcessed = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point stop;
+    };
+
+    using Function = void (*)(State&);
+
+    struct Entry {
+        const char* name;
+        Function function;
+    };
+
+    inline std::vector<Entry>& registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    inline int registerBenchmark(const char* name, Function function) {
+        registry().push_back(Entry{name, function});
+        return 0;
+    }
+
+    // Opciones: --filter <texto>, --min-time <segundos>, --csv
+    inline int runAll(int argc, char* argv[]) {
+        std::string filter;
+        double minTime = 0.5;
+        bool csv = false;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+                filter = argv[++i];
+            } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+                minTime = std::stod(argv[++i]);
+            } else if (std::strcmp(argv[i], "--csv") == 0) {
+                csv = true;
+            }
+        }
+
+        if (csv) {
+            std::printf("name,iterations,ns_per_op,mrays_per_s\n");
+        } else {
+            std::printf("%-36s %12s %14s %12s\n", "Benchmark", "Iterations", "ns/op", "Mrays/s");
+        }
+
+        for (const Entry& entry : registry()) {
+            if (!filter.empty() && std::string(entry.name).find(filter) == std::string::npos) {
+                continue;
+            }
+
+            // Crece el numero de iteraciones hasta que la corrida dure al menos minTime
+            uint64_t iterations = 1;
+            while (true) {
+                State state(iterations);
+                entry.function(state);
+                double seconds = state.elapsedSeconds();
+                if (seconds >= minTime || iterations >= (1ull << 40)) {
+                    double nsPerOp = seconds * 1e9 / static_cast<double>(iterations);
+                    double mrays = state.getItemsProcessed() > 0 ? state.getItemsProcessed() / seconds / 1e6 : 0.0;
+                    if (csv) {
+                        std::printf("%s,%llu,%.3f,%.3f\n", entry.name, static_cast<unsigned long long>(iterations), nsPerOp, mrays);
+                    } else if (mrays > 0.0) {
+                        std::printf("%-36s %12llu %14.1f %12.2f\n", entry.name, static_cast<unsigned long long>(iterations), nsPerOp, mrays);
+                    } else {
+                        std::printf("%-36s %12llu %14.1f %12s\n", entry.name, static_cast<unsigned long long>(iterations), nsPerOp, "-");
+                    }
+                    break;
+                }
+                double scale = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+                iterations = static_cast<uint64_t>(static_cast<double>(iterations) * std::min(std::max(scale, 2.0), 10.0));
+            }
+        }
+        return 0;
+    }
+}
+
+#define BENCHMARK(function) static int function##_registered = bench::registerBenchmark(#function, function)
+#define BENCHMARK_MAIN() int main(int argc, char* argv[]) { return bench::runAll(argc, argv); }
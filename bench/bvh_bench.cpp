@@ -0,0 +1,107 @@
+// Rayos por segundo del BVH a medida que crece la cantidad de objetos
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../cube.h"
+#include "../bvh.h"
+
+namespace {
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    // Cubos unitarios en un volumen que crece con N para mantener la densidad constante.
+    // Solo se intersectan, asi que no necesitan material.
+    std::vector<Object*> makeScene(size_t count, std::mt19937& rng) {
+        float extent = std::cbrt(static_cast<float>(count)) * 2.0f;
+        std::uniform_real_distribution<float> coord(-extent, extent);
+
+        std::vector<Object*> objects;
+        objects.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            objects.push_back(new Cube(glm::vec3(coord(rng), coord(rng), coord(rng)), 1.0f, NO_MATERIAL));
+        }
+        return objects;
+    }
+
+    std::vector<Ray> makeRays(size_t count, float extent, std::mt19937& rng) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<Ray> rays(count);
+        for (auto& ray : rays) {
+            ray.origin = glm::vec3(unit(rng), unit(rng), unit(rng)) * extent;
+            ray.direction = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 0.001f));
+        }
+        return rays;
+    }
+
+    double seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main() {
+    std::mt19937 rng(1234);
+    const size_t rayCount = 200000;
+
+    std::printf("%10s %12s %10s %14s %14s\n", "objects", "build (ms)", "nodes", "BVH rays/s", "linear rays/s");
+    for (size_t count : {100, 1000, 10000, 100000, 1000000}) {
+        std::vector<Object*> objects = makeScene(count, rng);
+        std::vector<Ray> rays = makeRays(rayCount, std::cbrt(static_cast<float>(count)) * 2.0f, rng);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<AABB> bounds;
+        bounds.reserve(objects.size());
+        for (const auto& object : objects) {
+            bounds.push_back(object->getBounds());
+        }
+        BVH bvh;
+        bvh.build(bounds);
+        double buildTime = seconds(start);
+
+        size_t hits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const Ray& ray : rays) {
+            float tMax = std::numeric_limits<float>::infinity();
+            bvh.traverse(ray.origin, ray.direction, tMax, [&](uint32_t prim, float& t) {
+                Intersect i = objects[prim]->rayIntersect(ray.origin, ray.direction);
+                if (i.isIntersecting && i.dist >= 0 && i.dist < t) {
+                    t = i.dist;
+                }
+            });
+            hits += tMax != std::numeric_limits<float>::infinity();
+        }
+        double bvhRate = rayCount / seconds(start);
+
+        // El recorrido lineal solo se mide donde termina en un tiempo razonable
+        double linearRate = 0.0;
+        if (count <= 10000) {
+            size_t linearRays = rayCount / 10;
+            start = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < linearRays; ++r) {
+                float tMax = std::numeric_limits<float>::infinity();
+                for (const auto& object : objects) {
+                    Intersect i = object->rayIntersect(rays[r].origin, rays[r].direction);
+                    if (i.isIntersecting && i.dist >= 0 && i.dist < tMax) {
+                        tMax = i.dist;
+                    }
+                }
+                hits += tMax != std::numeric_limits<float>::infinity();
+            }
+            linearRate = linearRays / seconds(start);
+        }
+
+        if (linearRate > 0.0) {
+            std::printf("%10zu %12.1f %10zu %14.0f %14.0f\n", count, buildTime * 1000.0, bvh.nodeCount(), bvhRate, linearRate);
+        } else {
+            std::printf("%10zu %12.1f %10zu %14.0f %14s\n", count, buildTime * 1000.0, bvh.nodeCount(), bvhRate, "-");
+        }
+
+        for (auto& object : objects) {
+            delete object;
+        }
+    }
+    return 0;
+}
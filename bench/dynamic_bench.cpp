@@ -0,0 +1,122 @@
+// Objetos en movimiento: K x K casas instanciadas de las que M avanzan en cada cuadro.
+// Mide updateTransforms() (refit y reconstruccion en segundo plano) contra reconstruir el BVH
+// completo, el crecimiento del costo SAH y el tiempo del cuadro. En cada cuadro compara el corte
+// mas cercano y la oclusion del arbol ajustado con los de uno recien construido; si difieren
+// termina con error.
+//   dynamic_bench [K] [M por cuadro]
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../house.h"
+#include "../instance.h"
+#include "../raytracer.h"
+#include "../scene.h"
+
+namespace {
+    const float SPACING = 8.0f;
+    const int FRAMES = 120;
+    const int CHECK_RAYS = 4096;
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Rayos desde arriba del terreno: cuantos dan otro corte u otra oclusion en 'fresh'
+    int mismatches(const PrimitiveSet& refitted, const PrimitiveSet& fresh, float extent, std::mt19937& random) {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        int count = 0;
+        for (int i = 0; i < CHECK_RAYS; i++) {
+            glm::vec3 origin(unit(random) * extent, 2.0f + unit(random) * 8.0f, -unit(random) * extent);
+            glm::vec3 direction = glm::normalize(glm::vec3(unit(random) - 0.5f, -unit(random), unit(random) - 0.5f));
+            float tRefitted = extent, tFresh = extent;
+            PrimitiveRef primRefitted, primFresh;
+            bool hitRefitted = refitted.intersect(origin, direction, tRefitted, primRefitted);
+            bool hitFresh = fresh.intersect(origin, direction, tFresh, primFresh);
+            float tOccRefitted, tOccFresh;
+            bool occRefitted = refitted.occluded(origin, direction, extent, PrimitiveRef(), tOccRefitted);
+            bool occFresh = fresh.occluded(origin, direction, extent, PrimitiveRef(), tOccFresh);
+            if (hitRefitted != hitFresh || (hitRefitted && tRefitted != tFresh) || occRefitted != occFresh ||
+                (occRefitted && tOccRefitted != tOccFresh)) {
+                count++;
+            }
+        }
+        return count;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::stoi(argv[1]) : 64;
+    int movedPerFrame = argc > 2 ? std::stoi(argv[2]) : 64;
+
+    Scene scene;
+    setUp(scene);
+    auto model = std::make_shared<Model>();
+    model->objects = std::move(scene.objects);
+    scene.objects.clear();
+    model->build();
+    for (int z = 0; z < side; z++) {
+        for (int x = 0; x < side; x++) {
+            scene.objects.push_back(new Instance(model, glm::vec3(x * SPACING, 0.0f, -z * SPACING)));
+        }
+    }
+    scene.build();
+
+    // Lo que costaria reconstruir en cada cuadro
+    PrimitiveSet full;
+    auto start = std::chrono::steady_clock::now();
+    full.build(scene.objects);
+    std::printf("%d instances, full BVH build %.2f ms\n", side * side, msSince(start));
+
+    float extent = side * SPACING;
+    Camera camera(glm::vec3(-SPACING, extent * 0.4f + 6.0f, SPACING), glm::vec3(extent * 0.5f, 0.0f, -extent * 0.5f),
+                  glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+    ThreadPool pool;
+    Framebuffer framebuffer(400, 300);
+
+    // Las casas que se mueven van en linea recta, cada una con su velocidad
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> pick(0, side * side - 1);
+    std::uniform_real_distribution<float> speed(-SPACING * 0.25f, SPACING * 0.25f);
+    std::vector<Object*> movers;
+    std::vector<glm::vec3> velocities;
+    for (int i = 0; i < movedPerFrame; i++) {
+        movers.push_back(scene.objects[pick(random)]);
+        velocities.emplace_back(speed(random), 0.0f, speed(random));
+    }
+
+    std::printf("%6s %12s %10s %12s\n", "frame", "update", "sah", "frame");
+    float lastGrowth = scene.primitives.costGrowth();
+    int rebuilds = 0;
+    std::mt19937 checkRandom(11);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        for (size_t i = 0; i < movers.size(); i++) {
+            movers[i]->translate(velocities[i]);
+        }
+        start = std::chrono::steady_clock::now();
+        scene.updateTransforms();
+        double updateMs = msSince(start);
+
+        start = std::chrono::steady_clock::now();
+        traceFrame(pool, scene, camera, framebuffer);
+        double traceMs = msSince(start);
+
+        // El costo solo baja de golpe cuando se adopta un arbol reconstruido
+        float growth = scene.primitives.costGrowth();
+        bool rebuilt = growth < lastGrowth * 0.9f;
+        rebuilds += rebuilt ? 1 : 0;
+        std::printf("%6d %9.3f ms %10.2f %9.1f ms%s\n", frame, updateMs, growth, traceMs, rebuilt ? "  rebuilt" : "");
+        lastGrowth = growth;
+
+        full.build(scene.objects);
+        if (int count = mismatches(scene.primitives, full, extent, checkRandom)) {
+            std::fprintf(stderr, "refit mismatch at frame %d: %d of %d rays\n", frame, count, CHECK_RAYS);
+            return 1;
+        }
+    }
+    std::printf("%d rebuilds adopted, refit matches a fresh build on %d rays\n", rebuilds, FRAMES * CHECK_RAYS);
+    return 0;
+}
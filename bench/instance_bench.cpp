@@ -0,0 +1,96 @@
+// Instancias contra copias: K x K casas del diorama como instancias de un solo modelo (giradas
+// de a 90 grados) o como bloques copiados en la malla. Mide build(), el cuadro y cuantos
+// primitivos quedan compilados: el modelo y las instancias, o las cajas de los bloques.
+//   instance_bench [K maximo]
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../cube.h"
+#include "../house.h"
+#include "../instance.h"
+#include "../raytracer.h"
+#include "../scene.h"
+
+namespace {
+    const float SPACING = 8.0f;
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Camara sobre la esquina del terreno mirando hacia el centro
+    Camera overview(int side) {
+        float extent = side * SPACING;
+        return Camera(glm::vec3(-SPACING, extent * 0.4f + 6.0f, SPACING), glm::vec3(extent * 0.5f, 0.0f, -extent * 0.5f),
+                      glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+    }
+
+    double frameMs(const Scene& scene, const Camera& camera) {
+        ThreadPool pool;
+        Framebuffer framebuffer(400, 300);
+        double best = 1e30;
+        for (int i = 0; i < 3; i++) {
+            auto start = std::chrono::steady_clock::now();
+            traceFrame(pool, scene, camera, framebuffer);
+            best = std::min(best, msSince(start));
+        }
+        return best;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int maxSide = argc > 1 ? std::stoi(argv[1]) : 64;
+
+    std::printf("%8s %10s %12s %12s %10s %12s %12s\n", "houses", "inst prims", "inst build", "inst frame",
+                "copy prims", "copy build", "copy frame");
+    for (int side = 4; side <= maxSide; side *= 4) {
+        // Instancias: los cubos de la casa se compilan una vez en el modelo
+        Scene instanced;
+        setUp(instanced);
+        auto model = std::make_shared<Model>();
+        model->objects = std::move(instanced.objects);
+        instanced.objects.clear();
+        model->build();
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                auto* house = new Instance(model, glm::vec3(x * SPACING, 0.0f, -z * SPACING));
+                house->rotate(glm::radians(90.0f * ((x + z) % 4)), glm::vec3(0.0f, 1.0f, 0.0f));
+                instanced.objects.push_back(house);
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        instanced.build();
+        double instancedBuild = msSince(start);
+        size_t instancedPrims = model->getPrimitives().cubes.centers.size() + instanced.primitives.instances.instances.size();
+
+        // Copias: cada casa son sus bloques en la malla, sin girar
+        Scene copied;
+        setUp(copied);
+        std::vector<Object*> houseCubes = std::move(copied.objects);
+        copied.objects.clear();
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                glm::vec3 offset(x * SPACING, 0.0f, -z * SPACING);
+                for (const Object* object : houseCubes) {
+                    const auto* cube = static_cast<const Cube*>(object);
+                    copied.objects.push_back(new Cube(cube->getCenter() + offset, cube->getSize(), cube->material));
+                }
+            }
+        }
+        for (Object* object : houseCubes) {
+            delete object;
+        }
+        start = std::chrono::steady_clock::now();
+        copied.build();
+        double copiedBuild = msSince(start);
+        size_t copiedPrims = copied.blocks.cells.size();
+
+        Camera camera = overview(side);
+        std::printf("%8d %10zu %10.1f ms %10.1f ms %10zu %10.1f ms %10.1f ms\n", side * side, instancedPrims,
+                    instancedBuild, frameMs(instanced, camera), copiedPrims, copiedBuild, frameMs(copied, camera));
+    }
+    return 0;
+}
@@ -0,0 +1,386 @@
+// Microbenchmarks de los nucleos de interseccion y sombreado, en ns/op y Mrays/s
+//   kernels_bench [--filter texto] [--min-time segundos] [--csv]
+// La salida --csv sirve para comparar corridas y detectar regresiones.
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "../glm/glm.hpp"
+#include "../boxset.h"
+#include "../cube.h"
+#include "../sphere.h"
+#include "../scene.h"
+#include "../house.h"
+#include "../raytracer.h"
+
+namespace {
+
+    const int RAY_COUNT = 4096;
+
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    // Rayos primarios de la camara sobre una malla de width x height, igual que beginFrame
+    std::vector<Ray> cameraRays(const Camera& camera, int width, int height) {
+        const float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+        glm::vec3 cameraDir = glm::normalize(camera.target - camera.position);
+        glm::vec3 cameraX = glm::normalize(glm::cross(cameraDir, camera.up));
+        glm::vec3 cameraY = glm::normalize(glm::cross(cameraX, cameraDir));
+        float tanHalfFov = tan(FOV / 2.0f);
+
+        std::vector<Ray> rays;
+        rays.reserve(width * height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                float screenX = ((2.0f * (x + 0.5f)) / width - 1.0f) * aspectRatio * tanHalfFov;
+                float screenY = (-(2.0f * (y + 0.5f)) / height + 1.0f) * tanHalfFov;
+                rays.push_back({camera.position, glm::normalize(cameraDir + cameraX * screenX + cameraY * screenY)});
+            }
+        }
+        return rays;
+    }
+
+    // Rayos desde puntos cercanos hacia la primitiva centrada en el origen; ~la mitad fallan
+    std::vector<Ray> primitiveRays() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+        std::vector<Ray> rays;
+        rays.reserve(RAY_COUNT);
+        for (int i = 0; i < RAY_COUNT; i++) {
+            glm::vec3 origin(offset(rng) * 4.0f, offset(rng) * 4.0f, 5.0f);
+            glm::vec3 target(offset(rng) * 1.2f, offset(rng) * 1.2f, 0.0f);
+            rays.push_back({origin, glm::normalize(target - origin)});
+        }
+        return rays;
+    }
+
+    Material plainMaterial() {
+        return {Color(200, 120, 40), 0.8f, 0.3f, 10.0f, 0.0f, 0.0f, 1.0f, nullptr};
+    }
+
+    // Muro de esferas y cubos no unitarios (todo pasa por el BVH) frente a la camara
+    std::unique_ptr<Scene> wallScene(const Material& wallMaterial) {
+        auto scene = std::make_unique<Scene>();
+        MaterialId material = scene->materials.add(wallMaterial);
+        MaterialId backdrop = scene->materials.add(plainMaterial());
+        for (int y = -6; y < 6; y++) {
+            for (int x = -8; x < 8; x++) {
+                glm::vec3 center(x + 0.5f, y + 0.5f, 0.0f);
+                if ((x + y) & 1) {
+                    scene->objects.push_back(new Sphere(center, 0.45f, material));
+                } else {
+                    scene->objects.push_back(new Cube(center, 0.8f, material));
+                }
+            }
+        }
+        // Fondo detras del muro para que los rayos secundarios golpeen algo
+        for (int y = -6; y < 6; y++) {
+            for (int x = -8; x < 8; x++) {
+                scene->objects.push_back(new Cube(glm::vec3(x + 0.5f, y + 0.5f, -3.0f), 0.95f, backdrop));
+            }
+        }
+        scene->light.position = glm::vec3(-5.0f, 5.0f, 10.0f);
+        scene->build();
+        return scene;
+    }
+
+    const Camera& wallCamera() {
+        static Camera camera(glm::vec3(0.0f, 0.0f, 12.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+        return camera;
+    }
+
+    const std::vector<Ray>& wallRays() {
+        static std::vector<Ray> rays = cameraRays(wallCamera(), 64, 64);
+        return rays;
+    }
+
+    const Scene& plainWall() {
+        static std::unique_ptr<Scene> scene = wallScene(plainMaterial());
+        return *scene;
+    }
+
+    const Scene& houseScene() {
+        static std::unique_ptr<Scene> scene = [] {
+            auto s = std::make_unique<Scene>();
+            setUp(*s);
+            s->build();
+            return s;
+        }();
+        return *scene;
+    }
+
+    // Origenes de sombra: los impactos de los rayos primarios contra la casa
+    struct ShadowQuery {
+        glm::vec3 origin;
+        glm::vec3 lightDir;
+        PrimitiveRef prim;
+    };
+
+    const std::vector<ShadowQuery>& houseShadowQueries() {
+        static std::vector<ShadowQuery> queries = [] {
+            const Scene& scene = houseScene();
+            std::vector<ShadowQuery> result;
+            for (const Ray& ray : cameraRays(houseCamera(), 80, 60)) {
+                SceneHit hit;
+                if (closestHit(scene, ray.origin, ray.direction, hit)) {
+                    glm::vec3 point = hit.intersect.point;
+                    result.push_back({point, glm::normalize(scene.light.position - point), hit.prim});
+                }
+            }
+            return result;
+        }();
+        return queries;
+    }
+
+    // Impactos en el muro y en el fondo que este tapa: las sombras pasan por el BVH
+    const std::vector<ShadowQuery>& wallShadowQueries() {
+        static std::vector<ShadowQuery> queries = [] {
+            const Scene& scene = plainWall();
+            std::vector<ShadowQuery> result;
+            for (const Ray& ray : wallRays()) {
+                SceneHit hit;
+                if (closestHit(scene, ray.origin, ray.direction, hit)) {
+                    glm::vec3 point = hit.intersect.point;
+                    result.push_back({point, glm::normalize(scene.light.position - point), hit.prim});
+                }
+            }
+            return result;
+        }();
+        return queries;
+    }
+}
+
+// Los kernels de interseccion no leen el material: los objetos sueltos usan NO_MATERIAL
+void BM_CubeRayIntersect(bench::State& state) {
+    Cube cube(glm::vec3(0.0f), 1.0f, NO_MATERIAL);
+    const std::vector<Ray> rays = primitiveRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ & (RAY_COUNT - 1)];
+        bench::doNotOptimize(cube.rayIntersect(ray.origin, ray.direction));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CubeRayIntersect);
+
+// Solo la prueba candidata, sin punto, normal ni uv
+void BM_CubeRayDistance(bench::State& state) {
+    Cube cube(glm::vec3(0.0f), 1.0f, NO_MATERIAL);
+    const std::vector<Ray> rays = primitiveRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ & (RAY_COUNT - 1)];
+        float t;
+        bench::doNotOptimize(cube.rayDistance(ray.origin, ray.direction, t));
+        bench::doNotOptimize(t);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CubeRayDistance);
+
+// Un rayo contra 8 cubos: 8 llamadas virtuales contra una llamada a BoxSet::nearest
+std::vector<Cube> eightCubes() {
+    std::vector<Cube> cubes;
+    for (int i = 0; i < 8; i++) {
+        cubes.emplace_back(glm::vec3((i % 4) * 0.6f - 0.9f, (i / 4) * 0.6f - 0.3f, -0.2f * i), 0.5f, NO_MATERIAL);
+    }
+    return cubes;
+}
+
+void BM_CubeRayIntersect8(bench::State& state) {
+    std::vector<Cube> cubes = eightCubes();
+    std::vector<const Object*> objects;
+    for (const Cube& cube : cubes) {
+        objects.push_back(&cube);
+    }
+    const std::vector<Ray> rays = primitiveRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ & (RAY_COUNT - 1)];
+        float closest = std::numeric_limits<float>::infinity();
+        for (const Object* object : objects) {
+            float t;
+            if (object->rayDistance(ray.origin, ray.direction, t) && t < closest) {
+                closest = t;
+            }
+        }
+        bench::doNotOptimize(closest);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CubeRayIntersect8);
+
+void BM_BoxSetNearest8(bench::State& state) {
+    BoxSet boxes;
+    for (const Cube& cube : eightCubes()) {
+        boxes.add(cube.getBounds());
+    }
+    const std::vector<Ray> rays = primitiveRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ & (RAY_COUNT - 1)];
+        float closest = std::numeric_limits<float>::infinity();
+        bench::doNotOptimize(boxes.nearest(ray.origin, 1.0f / ray.direction, 0, 8, 0.0f, closest));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoxSetNearest8);
+
+void BM_SphereRayIntersect(bench::State& state) {
+    Sphere sphere(glm::vec3(0.0f), 0.5f, NO_MATERIAL);
+    const std::vector<Ray> rays = primitiveRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ & (RAY_COUNT - 1)];
+        bench::doNotOptimize(sphere.rayIntersect(ray.origin, ray.direction));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SphereRayIntersect);
+
+void BM_CastShadowHouse(bench::State& state) {
+    const Scene& scene = houseScene();
+    const std::vector<ShadowQuery>& queries = houseShadowQueries();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const ShadowQuery& query = queries[i++ % queries.size()];
+        bench::doNotOptimize(castShadow(scene, query.origin, query.lightDir, query.prim));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CastShadowHouse);
+
+void BM_CastShadowWall(bench::State& state) {
+    const Scene& scene = plainWall();
+    const std::vector<ShadowQuery>& queries = wallShadowQueries();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const ShadowQuery& query = queries[i++ % queries.size()];
+        bench::doNotOptimize(castShadow(scene, query.origin, query.lightDir, query.prim));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CastShadowWall);
+
+void BM_CastRayPlain(bench::State& state) {
+    const Scene& scene = plainWall();
+    const std::vector<Ray>& rays = wallRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ % rays.size()];
+        bench::doNotOptimize(castRay(scene, ray.origin, ray.direction));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CastRayPlain);
+
+// Cada impacto lanza un rayo reflejado y uno refractado
+void BM_CastRayReflectRefract(bench::State& state) {
+    Material glass = plainMaterial();
+    glass.reflectivity = 0.3f;
+    glass.transparency = 0.5f;
+    glass.refractionIndex = 1.5f;
+    static std::unique_ptr<Scene> scene = wallScene(glass);
+    const std::vector<Ray>& rays = wallRays();
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ % rays.size()];
+        bench::doNotOptimize(castRay(*scene, ray.origin, ray.direction));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CastRayReflectRefract);
+
+void BM_CastRayHouse(bench::State& state) {
+    const Scene& scene = houseScene();
+    static std::vector<Ray> rays = cameraRays(houseCamera(), 80, 60);
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const Ray& ray = rays[i++ % rays.size()];
+        bench::doNotOptimize(castRay(scene, ray.origin, ray.direction));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CastRayHouse);
+
+// Visibilidad primaria del muro: rayo por rayo contra paquetes de 8x8 (wallRays es 64x64)
+void BM_PrimaryHitsPerRay(bench::State& state) {
+    const Scene& scene = plainWall();
+    const std::vector<Ray>& rays = wallRays();
+    for ([[maybe_unused]] auto _ : state) {
+        for (const Ray& ray : rays) {
+            SceneHit hit;
+            bench::doNotOptimize(closestHit(scene, ray.origin, ray.direction, hit));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_PrimaryHitsPerRay);
+
+void BM_PrimaryHitsPacket(bench::State& state) {
+    const Scene& scene = plainWall();
+    const std::vector<Ray>& rays = wallRays();
+    glm::vec3 directions[PACKET_SIZE * PACKET_SIZE];
+    SceneHit hits[PACKET_SIZE * PACKET_SIZE];
+    for ([[maybe_unused]] auto _ : state) {
+        for (int packetY = 0; packetY < 64; packetY += PACKET_SIZE) {
+            for (int packetX = 0; packetX < 64; packetX += PACKET_SIZE) {
+                int count = 0;
+                for (int y = packetY; y < packetY + PACKET_SIZE; y++) {
+                    for (int x = packetX; x < packetX + PACKET_SIZE; x++) {
+                        directions[count++] = rays[y * 64 + x].direction;
+                    }
+                }
+                closestHitPacket(scene, wallCamera().position, directions, count, hits);
+                bench::doNotOptimize(hits[0]);
+            }
+        }
+    }
+    state.setItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_PrimaryHitsPacket);
+
+// Reemplazo de getColorFromSurface: muestreo de una textura 16x16 del TextureStore
+void BM_TextureSample(bench::State& state) {
+    static TextureStore store;
+    static const Texture* texture = [] {
+        std::vector<uint8_t> rgba(16 * 16 * 4);
+        for (size_t i = 0; i < rgba.size(); i++) {
+            rgba[i] = static_cast<uint8_t>(i * 37);
+        }
+        return store.add(16, 16, rgba.data());
+    }();
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-1.0f, 1.0f);
+    std::vector<glm::vec2> uvs(RAY_COUNT);
+    for (glm::vec2& uv : uvs) {
+        uv = glm::vec2(coord(rng), coord(rng));
+    }
+
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const glm::vec2& uv = uvs[i++ & (RAY_COUNT - 1)];
+        bench::doNotOptimize(texture->sample(uv.x, uv.y));
+    }
+}
+BENCHMARK(BM_TextureSample);
+
+// Cuadro completo de 400x300 del diorama con un hilo; items = pixeles
+void BM_TraceFrameHouse(bench::State& state) {
+    const Scene& scene = houseScene();
+    static ThreadPool pool(1);
+    static Framebuffer framebuffer(400, 300);
+    Camera camera = houseCamera();
+    for ([[maybe_unused]] auto _ : state) {
+        traceFrame(pool, scene, camera, framebuffer);
+    }
+    state.setItemsProcessed(state.iterations() * framebuffer.getWidth() * framebuffer.getHeight());
+}
+BENCHMARK(BM_TraceFrameHouse);
+
+BENCHMARK_MAIN()
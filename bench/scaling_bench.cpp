@@ -0,0 +1,47 @@
+// Tiempo por cuadro del diorama con 1, 2, 4, ... hasta N hilos
+//   scaling_bench [N]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "../scene.h"
+#include "../house.h"
+#include "../raytracer.h"
+
+int main(int argc, char* argv[]) {
+    unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::stoi(argv[1])) : std::thread::hardware_concurrency();
+    maxThreads = std::max(1u, maxThreads);
+
+    // Sin decodificador: los materiales usan su color difuso
+    Scene scene;
+    setUp(scene);
+    scene.build();
+    Camera camera = houseCamera();
+    Framebuffer framebuffer(400, 300);
+
+    const int frames = 10;
+    double baseline = 0.0;
+
+    std::printf("threads   ms/frame   speedup\n");
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        ThreadPool pool(threads);
+        traceFrame(pool, scene, camera, framebuffer);  // calentamiento
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) {
+            traceFrame(pool, scene, camera, framebuffer);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+        if (threads == 1) {
+            baseline = ms;
+        }
+        std::printf("%7u %10.2f %9.2fx\n", threads, ms, baseline / ms);
+
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
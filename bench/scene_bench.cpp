@@ -0,0 +1,84 @@
+// Tiempo de carga de escenas de 1K a 1M bloques en texto y en binario, sin contar build()
+//   scene_bench [carpeta temporal]
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../scene.h"
+#include "../scenefile.h"
+
+namespace {
+    // Terreno de columnas de altura variable sobre un cuadrado, con cuatro materiales por capas
+    SceneFile makeWorld(size_t count) {
+        SceneFile world;
+        for (int i = 0; i < 4; i++) {
+            world.materials.push_back({{uint8_t(60 * i), 120, 80, 255}, 0.3f, 0.5f, 3.0f, 0.0f, 0.0f, 1.6f, -1});
+        }
+        int side = 1;
+        while (static_cast<size_t>(side) * side * 4 < count) {
+            side++;
+        }
+        for (int z = 0; z < side && world.blocks.size() < count; z++) {
+            for (int x = 0; x < side && world.blocks.size() < count; x++) {
+                int height = 2 + (x * 7 + z * 13) % 5;
+                for (int y = 0; y < height && world.blocks.size() < count; y++) {
+                    world.blocks.push_back({x, y, -z, static_cast<uint32_t>(y * 4 / height)});
+                }
+            }
+        }
+        return world;
+    }
+
+    bool writeText(const std::string& file, const SceneFile& world) {
+        std::ofstream out(file);
+        for (size_t i = 0; i < world.materials.size(); i++) {
+            const MaterialRecord& m = world.materials[i];
+            out << "material m" << i << " " << int(m.color[0]) << " " << int(m.color[1]) << " " << int(m.color[2]) << " "
+                << m.albedo << " " << m.specularAlbedo << " " << m.specularCoefficient << " " << m.reflectivity << " "
+                << m.transparency << " " << m.refractionIndex << "\n";
+        }
+        for (const BlockRecord& block : world.blocks) {
+            out << "block " << block.x << " " << block.y << " " << block.z << " m" << block.material << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    double load(const std::string& file, size_t& solid) {
+        Scene scene;
+        Camera camera(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+        auto start = std::chrono::steady_clock::now();
+        if (!loadScene(file, scene, camera)) {
+            return -1.0;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        solid = scene.grid.size();
+        return ms;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string folder = argc > 1 ? argv[1] : ".";
+
+    std::printf("%10s %12s %12s %12s\n", "blocks", "text (ms)", "binary (ms)", "binary MB");
+    for (size_t count : {1000, 10000, 100000, 1000000}) {
+        SceneFile world = makeWorld(count);
+        std::string textFile = folder + "/scene_bench.scene";
+        std::string binaryFile = folder + "/scene_bench.sceneb";
+        if (!writeText(textFile, world) || !writeSceneBinary(binaryFile, world)) {
+            return 1;
+        }
+
+        size_t textSolid = 0, binarySolid = 0;
+        double textMs = load(textFile, textSolid);
+        double binaryMs = load(binaryFile, binarySolid);
+        if (textMs < 0.0 || binaryMs < 0.0 || textSolid != world.blocks.size() || binarySolid != world.blocks.size()) {
+            std::fprintf(stderr, "load mismatch at %zu blocks\n", count);
+            return 1;
+        }
+        std::printf("%10zu %12.1f %12.1f %12.1f\n", count, textMs, binaryMs, world.blocks.size() * sizeof(BlockRecord) / 1e6);
+    }
+    std::remove((folder + "/scene_bench.scene").c_str());
+    std::remove((folder + "/scene_bench.sceneb").c_str());
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Muestras de textura por segundo: acceso estilo superficie SDL (getColorFromSurface) vs TextureStore
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../glm/glm.hpp"
+#include "../texture.h"
+
+namespace {
+    // Superficie generica como la que devolvia IMG_Load: pitch, bytes por pixel y mascaras
+    struct Surface {
+        int w, h, pitch, bytesPerPixel;
+        uint32_t masks[4];
+        int shifts[4];
+        const uint8_t* pixels;
+    };
+
+    // Copia del muestreo anterior: memcpy de BytesPerPixel y decodificacion del formato
+    // por texel, lo mismo que hace SDL_GetRGBA con un formato de 32 bits
+    Color getColorFromSurface(const Surface* surface, float u, float v) {
+        Color color = {0, 0, 0, 0};
+        if (u < 0) u += 1.0f;
+        if (v < 0) v += 1.0f;
+        float temp = u;
+        u = v;
+        v = 1.0f - temp;
+        int x = std::min(static_cast<int>(u * surface->w), surface->w - 1);
+        int y = std::min(static_cast<int>(v * surface->h), surface->h - 1);
+        uint32_t pixel = 0;
+        const uint8_t *p = surface->pixels + y * surface->pitch + x * surface->bytesPerPixel;
+        memcpy(&pixel, p, surface->bytesPerPixel);
+        color.r = static_cast<uint8_t>((pixel & surface->masks[0]) >> surface->shifts[0]);
+        color.g = static_cast<uint8_t>((pixel & surface->masks[1]) >> surface->shifts[1]);
+        color.b = static_cast<uint8_t>((pixel & surface->masks[2]) >> surface->shifts[2]);
+        color.a = static_cast<uint8_t>((pixel & surface->masks[3]) >> surface->shifts[3]);
+        return color;
+    }
+
+    template <typename Sample>
+    double samplesPerSecond(const std::vector<glm::vec2>& uvs, int rounds, Sample&& sample) {
+        unsigned sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (const glm::vec2& uv : uvs) {
+                Color c = sample(uv.x, uv.y);
+                sink += c.r + c.g + c.b;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (sink == 1) {
+            std::printf("%u\n", sink);
+        }
+        return static_cast<double>(uvs.size()) * rounds / seconds;
+    }
+}
+
+int main() {
+    // Mismo tamaño que oak.png: 358x358, se guarda como 512x512
+    const int width = 358;
+    const int height = 358;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (auto& value : rgba) {
+        value = static_cast<uint8_t>(byte(rng));
+    }
+
+    TextureStore store;
+    const Texture* texture = store.add(width, height, rgba.data());
+
+    std::uniform_real_distribution<float> coord(-0.5f, 1.0f);
+    std::vector<glm::vec2> uvs(1 << 20);
+    for (auto& uv : uvs) {
+        uv = glm::vec2(coord(rng), coord(rng));
+    }
+
+    const int rounds = 10;
+    double storeRate = samplesPerSecond(uvs, rounds, [&](float u, float v) {
+        return texture->sample(u, v);
+    });
+
+    Surface surface = {width, height, width * 4, 4,
+                       {0x000000ffu, 0x0000ff00u, 0x00ff0000u, 0xff000000u}, {0, 8, 16, 24}, rgba.data()};
+    double surfaceRate = samplesPerSecond(uvs, rounds, [&](float u, float v) {
+        return getColorFromSurface(&surface, u, v);
+    });
+
+    std::printf("texel samples/s\n");
+    std::printf("  surface-style: %8.1f M\n", surfaceRate / 1e6);
+    std::printf("  TextureStore:  %8.1f M\n", storeRate / 1e6);
+    std::printf("  speedup:       %8.2fx\n", storeRate / surfaceRate);
+    return 0;
+}
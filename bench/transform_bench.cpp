@@ -0,0 +1,96 @@
+// Costo de las transformaciones del sombreado por impacto: antes (matrices
+// reconstruidas e invertidas en cada uso) y despues (matrices cacheadas en Object)
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../cube.h"
+
+namespace {
+    // Lo que hacia Object::getTransformMatrix() en cada llamada
+    glm::mat4 rebuildTransform(const Object& object) {
+        glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), object.position);
+        glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), object.rotationAngle, object.rotationAxis);
+        glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), object.scale);
+        return translationMatrix * rotationMatrix * scaleMatrix;
+    }
+
+    struct Hit {
+        const Object* object;
+        glm::vec3 point;
+        glm::vec3 normal;
+    };
+
+    template <typename Shade>
+    double nsPerHit(const std::vector<Hit>& hits, int rounds, Shade&& shade) {
+        glm::vec3 sink(0.0f);
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (const Hit& hit : hits) {
+                sink += shade(hit);
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (sink.x == 12345.0f) {
+            std::printf("%f\n", sink.y);
+        }
+        return ns / (static_cast<double>(hits.size()) * rounds);
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // Solo importan las matrices; los cubos no se sombrean
+    std::vector<Object*> objects;
+    for (int i = 0; i < 256; ++i) {
+        Object* cube = new Cube(glm::vec3(unit(rng), unit(rng), unit(rng)) * 10.0f, 1.0f, NO_MATERIAL);
+        cube->translate(glm::vec3(unit(rng), 0.0f, unit(rng)));
+        cube->rotate(unit(rng), glm::vec3(1.0f, 0.0f, 0.0f));
+        cube->updateTransform();
+        objects.push_back(cube);
+    }
+
+    std::vector<Hit> hits(100000);
+    for (size_t i = 0; i < hits.size(); ++i) {
+        hits[i] = Hit{objects[i % objects.size()], glm::vec3(unit(rng), unit(rng), unit(rng)) * 5.0f,
+                      glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)))};
+    }
+
+    const glm::vec3 lightPosition(-10.0f, 0.0f, 10.0f);
+    const glm::vec3 rayOrigin(0.0f, 3.0f, 10.0f);
+    const int rounds = 20;
+
+    // Antes: cuatro inversas por impacto, como castRay con reflexion y refraccion
+    double before = nsPerHit(hits, rounds, [&](const Hit& hit) {
+        glm::vec3 lightDir = glm::mat3(glm::transpose(glm::inverse(rebuildTransform(*hit.object)))) * glm::normalize(lightPosition - hit.point);
+        glm::vec3 viewDir = glm::mat3(glm::transpose(glm::inverse(rebuildTransform(*hit.object)))) * glm::normalize(rayOrigin - hit.point);
+        glm::vec3 reflectDir = glm::reflect(-lightDir, hit.normal);
+        glm::vec3 reflected = glm::mat3(glm::transpose(glm::inverse(rebuildTransform(*hit.object)))) * reflectDir;
+        glm::vec3 refracted = glm::mat3(glm::transpose(glm::inverse(rebuildTransform(*hit.object)))) * glm::refract(glm::normalize(hit.point - rayOrigin), hit.normal, 1.5f);
+        return lightDir + viewDir + reflected + refracted;
+    });
+
+    // Despues: una lectura de la matriz de normales cacheada
+    double after = nsPerHit(hits, rounds, [&](const Hit& hit) {
+        const glm::mat3& normalMatrix = hit.object->getNormalMatrix();
+        glm::vec3 lightDir = normalMatrix * glm::normalize(lightPosition - hit.point);
+        glm::vec3 viewDir = normalMatrix * glm::normalize(rayOrigin - hit.point);
+        glm::vec3 reflectDir = glm::reflect(-lightDir, hit.normal);
+        glm::vec3 reflected = normalMatrix * reflectDir;
+        glm::vec3 refracted = normalMatrix * glm::refract(glm::normalize(hit.point - rayOrigin), hit.normal, 1.5f);
+        return lightDir + viewDir + reflected + refracted;
+    });
+
+    std::printf("per-hit transform cost\n");
+    std::printf("  rebuilt + inverted: %8.2f ns/hit\n", before);
+    std::printf("  cached:             %8.2f ns/hit\n", after);
+    std::printf("  speedup:            %8.2fx\n", before / after);
+
+    for (auto& object : objects) {
+        delete object;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Mundo por chunks en disco: escribe un terreno de N x N columnas, lo abre y recorre
+// con la camara midiendo el tiempo por cuadro y los chunks residentes con un presupuesto chico
+//   world_bench [N] [carpeta temporal]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../chunkedworld.h"
+#include "../raytracer.h"
+#include "../scene.h"
+#include "../scenefile.h"
+
+namespace {
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Colinas de 2 a 14 bloques: pasto arriba, tierra y piedra abajo
+    bool writeTerrain(const std::string& file, int columns) {
+        const int size = ChunkedWorld::CHUNK_SIZE;
+        int chunks = (columns + size - 1) / size;
+        ChunkedWorldWriter writer;
+        if (!writer.open(file, glm::ivec3(0, 0, -chunks + 1), glm::ivec3(chunks - 1, 0, 0))) {
+            return false;
+        }
+        std::vector<MaterialId> cells(ChunkedWorld::CHUNK_CELLS);
+        for (int cz = 0; cz < chunks; cz++) {
+            for (int cx = 0; cx < chunks; cx++) {
+                std::fill(cells.begin(), cells.end(), 0);
+                for (int z = 0; z < size; z++) {
+                    for (int x = 0; x < size; x++) {
+                        int wx = cx * size + x;
+                        int wz = cz * size + z;
+                        if (wx >= columns || wz >= columns) {
+                            continue;
+                        }
+                        int height = 8 + static_cast<int>(6.0f * std::sin(wx * 0.05f) * std::cos(wz * 0.07f));
+                        for (int y = 0; y < height; y++) {
+                            // z del mundo es negativo: la camara mira hacia -z
+                            int lz = size - 1 - z;
+                            cells[(lz * size + y) * size + x] = static_cast<MaterialId>(y == height - 1 ? 1 : y > height - 4 ? 2 : 3);
+                        }
+                    }
+                }
+                if (!writer.add(glm::ivec3(cx, 0, -cz), cells.data())) {
+                    return false;
+                }
+            }
+        }
+        return writer.close();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int columns = argc > 1 ? std::stoi(argv[1]) : 1024;
+    std::string folder = argc > 2 ? argv[2] : ".";
+    std::string worldFile = folder + "/world_bench.world";
+    std::string sceneFile = folder + "/world_bench.scene";
+
+    auto start = std::chrono::steady_clock::now();
+    if (!writeTerrain(worldFile, columns)) {
+        return 1;
+    }
+    std::printf("write %d x %d columns: %.1f ms, %.1f MB\n", columns, columns, msSince(start),
+                std::filesystem::file_size(worldFile) / 1e6);
+
+    {
+        std::ofstream scene(sceneFile);
+        scene << "world world_bench.world\n"
+              << "light 0 200 0 1.0 255 255 255\n"
+              << "camera 8 20 8  8 12 -40  0 1 0  10\n"
+              << "material grass 80 160 60 0.8 0.2 3 0 0 1\n"
+              << "material dirt 120 80 40 0.8 0.1 3 0 0 1\n"
+              << "material stone 120 120 120 0.8 0.3 3 0 0 1\n";
+    }
+
+    // Sin decodificador: los materiales usan su color difuso
+    Scene scene;
+    Camera camera(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+    start = std::chrono::steady_clock::now();
+    if (!loadScene(sceneFile, scene, camera)) {
+        return 1;
+    }
+    scene.build();
+    std::printf("open + build: %.2f ms, %zu blocks\n", msSince(start), scene.grid.size());
+
+    ChunkedWorld* world = scene.grid.getWorld();
+    world->setBudget(256);  // 2 MB
+
+    ThreadPool pool;
+    Framebuffer framebuffer(400, 300);
+    std::printf("%6s %12s %10s\n", "frame", "ms", "resident");
+    for (int frame = 0; frame < 16; frame++) {
+        scene.updateStreaming(camera);
+        start = std::chrono::steady_clock::now();
+        traceFrame(pool, scene, camera, framebuffer);
+        std::printf("%6d %12.1f %10zu\n", frame, msSince(start), world->residentCount());
+        glm::vec3 step = glm::vec3(columns / 32.0f, 0.0f, -columns / 32.0f);
+        camera.position += step;
+        camera.target += step;
+    }
+
+    std::filesystem::remove(worldFile);
+    std::filesystem::remove(sceneFile);
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "boxset.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <immintrin.h>
+#endif
+
+namespace {
+    const float INF = std::numeric_limits<float>::infinity();
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    inline int lowestBit(unsigned mask) {
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+    }
+#else
+    inline int lowestBit(unsigned mask) { return __builtin_ctz(mask); }
+#endif
+}
+
+void BoxSet::clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    count = 0;
+}
+
+uint32_t BoxSet::add(const AABB& box) {
+    minX.resize(count); minY.resize(count); minZ.resize(count);
+    maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+
+    minX.push_back(box.min.x); minY.push_back(box.min.y); minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x); maxY.push_back(box.max.y); maxZ.push_back(box.max.z);
+    pad();
+    return static_cast<uint32_t>(count++);
+}
+
+void BoxSet::pad() {
+    // Las cajas vacias de relleno tienen min = +inf y max = -inf
+    size_t padded = minX.size() + WIDTH - 1;
+    minX.resize(padded, INF); minY.resize(padded, INF); minZ.resize(padded, INF);
+    maxX.resize(padded, -INF); maxY.resize(padded, -INF); maxZ.resize(padded, -INF);
+}
+
+#if defined(__AVX2__)
+
+int BoxSet::nearest(const glm::vec3& rayOrigin, const glm::vec3& invDir, uint32_t first, uint32_t boxCount,
+                    float tMin, float& tMax, uint32_t skip) const {
+    const __m256 ox = _mm256_set1_ps(rayOrigin.x), oy = _mm256_set1_ps(rayOrigin.y), oz = _mm256_set1_ps(rayOrigin.z);
+    const __m256 ix = _mm256_set1_ps(invDir.x), iy = _mm256_set1_ps(invDir.y), iz = _mm256_set1_ps(invDir.z);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 lower = _mm256_set1_ps(tMin);
+    const __m256 inf = _mm256_set1_ps(INF);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    int best = -1;
+    const uint32_t end = first + boxCount;
+    for (uint32_t base = first; base < end; base += WIDTH) {
+        // Carriles dentro del rango y distintos de 'skip'
+        __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)), lanes);
+        __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(end)), index);
+        valid = _mm256_andnot_si256(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(static_cast<int>(skip))), valid);
+
+        __m256 x0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&minX[base]), ox), ix);
+        __m256 x1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&maxX[base]), ox), ix);
+        __m256 y0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&minY[base]), oy), iy);
+        __m256 y1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&maxY[base]), oy), iy);
+        __m256 z0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&minZ[base]), oz), iz);
+        __m256 z1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&maxZ[base]), oz), iz);
+
+        __m256 tNear = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(y0, y1)), _mm256_min_ps(z0, z1));
+        __m256 tFar = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(y0, y1)), _mm256_max_ps(z0, z1));
+
+        // Desde dentro de la caja el corte es la salida
+        __m256 t = _mm256_blendv_ps(tFar, tNear, _mm256_cmp_ps(tNear, zero, _CMP_GT_OQ));
+        __m256 hit = _mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), _mm256_cmp_ps(tFar, zero, _CMP_GE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, lower, _CMP_GE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, _mm256_set1_ps(tMax), _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_castsi256_ps(valid));
+
+        int hitMask = _mm256_movemask_ps(hit);
+        if (hitMask == 0) {
+            continue;
+        }
+
+        // Minimo horizontal de las distancias que cortan
+        __m256 candidates = _mm256_blendv_ps(inf, t, hit);
+        __m256 m = _mm256_min_ps(candidates, _mm256_permute2f128_ps(candidates, candidates, 1));
+        m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int lane = lowestBit(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(candidates, m, _CMP_EQ_OQ)) & hitMask));
+        tMax = _mm256_cvtss_f32(m);
+        best = static_cast<int>(base) + lane;
+    }
+    return best;
+}
+
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+
+int BoxSet::nearest(const glm::vec3& rayOrigin, const glm::vec3& invDir, uint32_t first, uint32_t boxCount,
+                    float tMin, float& tMax, uint32_t skip) const {
+    const __m128 ox = _mm_set1_ps(rayOrigin.x), oy = _mm_set1_ps(rayOrigin.y), oz = _mm_set1_ps(rayOrigin.z);
+    const __m128 ix = _mm_set1_ps(invDir.x), iy = _mm_set1_ps(invDir.y), iz = _mm_set1_ps(invDir.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 lower = _mm_set1_ps(tMin);
+
+    int best = -1;
+    const uint32_t end = first + boxCount;
+    // Bloques de 4: dos por cada bloque de WIDTH
+    for (uint32_t base = first; base < end; base += 4) {
+        int validMask = 0;
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (base + lane < end && base + lane != skip) {
+                validMask |= 1 << lane;
+            }
+        }
+
+        __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&minX[base]), ox), ix);
+        __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&maxX[base]), ox), ix);
+        __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&minY[base]), oy), iy);
+        __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&maxY[base]), oy), iy);
+        __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&minZ[base]), oz), iz);
+        __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&maxZ[base]), oz), iz);
+
+        __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_min_ps(z0, z1));
+        __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_max_ps(z0, z1));
+
+        // Desde dentro de la caja el corte es la salida
+        __m128 inside = _mm_cmpgt_ps(tNear, zero);
+        __m128 t = _mm_or_ps(_mm_and_ps(inside, tNear), _mm_andnot_ps(inside, tFar));
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpge_ps(tFar, zero));
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(t, lower));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(t, _mm_set1_ps(tMax)));
+
+        int hitMask = _mm_movemask_ps(hit) & validMask;
+        if (hitMask == 0) {
+            continue;
+        }
+
+        alignas(16) float distances[4];
+        _mm_store_ps(distances, t);
+        for (int lane = 0; lane < 4; ++lane) {
+            if ((hitMask & (1 << lane)) && distances[lane] < tMax) {
+                tMax = distances[lane];
+                best = static_cast<int>(base) + lane;
+            }
+        }
+    }
+    return best;
+}
+
+#else
+
+int BoxSet::nearest(const glm::vec3& rayOrigin, const glm::vec3& invDir, uint32_t first, uint32_t boxCount,
+                    float tMin, float& tMax, uint32_t skip) const {
+    int best = -1;
+    for (uint32_t i = first; i < first + boxCount; ++i) {
+        if (i == skip) {
+            continue;
+        }
+        glm::vec3 t0 = (glm::vec3(minX[i], minY[i], minZ[i]) - rayOrigin) * invDir;
+        glm::vec3 t1 = (glm::vec3(maxX[i], maxY[i], maxZ[i]) - rayOrigin) * invDir;
+        glm::vec3 tSmall = glm::min(t0, t1);
+        glm::vec3 tBig = glm::max(t0, t1);
+        float tNear = std::max(std::max(tSmall.x, tSmall.y), tSmall.z);
+        float tFar = std::min(std::min(tBig.x, tBig.y), tBig.z);
+        float t = tNear > 0.0f ? tNear : tFar;
+        if (tNear <= tFar && tFar >= 0.0f && t >= tMin && t < tMax) {
+            tMax = t;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "aabb.h"
+
+// Cajas alineadas a los ejes guardadas como estructura de arreglos (un arreglo por
+// coordenada de min y max) para probar un rayo contra WIDTH cajas a la vez.
+// Se compila con AVX2 si esta disponible (8 cajas por instruccion), si no con SSE
+// (dos pasadas de 4) y como ultimo recurso con un ciclo escalar.
+class BoxSet {
+public:
+    static const uint32_t WIDTH = 8;
+    static const uint32_t NO_SKIP = 0xFFFFFFFF;
+
+    void clear();
+
+    // Agrega una caja y devuelve su indice. Una AABB vacia (min > max) nunca se golpea.
+    uint32_t add(const AABB& box);
+
+    size_t size() const { return count; }
+
+    // La caja 'index' es real y no un lugar vacio
+    bool isBox(uint32_t index) const { return minX[index] <= maxX[index]; }
+
+    // Prueba las cajas [first, first + boxCount) con la misma regla que Cube::rayIntersect:
+    // la distancia es la de entrada, o la de salida si el origen esta dentro de la caja.
+    // Devuelve el indice del corte mas cercano con tMin <= t < tMax (y reduce tMax) o -1.
+    // La caja 'skip' se ignora.
+    int nearest(const glm::vec3& rayOrigin, const glm::vec3& invDir, uint32_t first, uint32_t boxCount,
+                float tMin, float& tMax, uint32_t skip = NO_SKIP) const;
+
+private:
+    void pad();
+
+    // Cada arreglo tiene WIDTH - 1 lugares vacios extra para leer bloques completos al final
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    size_t count = 0;
+};
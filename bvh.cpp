@@ -0,0 +1,169 @@
+#include "bvh.h"
+
+namespace {
+    const int BIN_COUNT = 16;
+    const int MAX_DEPTH = 60;  // la pila de traverse() tiene 64 entradas
+    const uint32_t NO_PARENT = 0xFFFFFFFF;
+
+    struct Bin {
+        AABB bounds;
+        uint32_t count = 0;
+    };
+}
+
+void BVH::build(const std::vector<AABB>& primBounds, uint32_t maxLeafSize) {
+    nodes.clear();
+    parents.clear();
+    leafOfPrim.clear();
+    costSum = 0.0;
+    primIndices.resize(primBounds.size());
+    if (primBounds.empty()) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids(primBounds.size());
+    for (uint32_t i = 0; i < primBounds.size(); ++i) {
+        primIndices[i] = i;
+        centroids[i] = primBounds[i].centroid();
+    }
+
+    nodes.reserve(primBounds.size() * 2);
+    nodes.push_back(BVHNode{AABB(), 0, static_cast<uint32_t>(primBounds.size())});
+    subdivide(0, primBounds, centroids, maxLeafSize, 0);
+    nodes.shrink_to_fit();
+
+    parents.assign(nodes.size(), NO_PARENT);
+    leafOfPrim.resize(primBounds.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const BVHNode& node = nodes[i];
+        if (node.isLeaf()) {
+            for (uint32_t j = node.leftOrFirst; j < node.leftOrFirst + node.count; ++j) {
+                leafOfPrim[primIndices[j]] = i;
+            }
+        } else {
+            parents[node.leftOrFirst] = i;
+            parents[node.leftOrFirst + 1] = i;
+        }
+        costSum += nodeCost(node);
+    }
+}
+
+void BVH::refit(const std::vector<AABB>& primBounds, const std::vector<uint32_t>& changed) {
+    for (uint32_t prim : changed) {
+        // Sube desde la hoja; si un nodo no cambia, sus ancestros tampoco
+        for (uint32_t current = leafOfPrim[prim]; current != NO_PARENT; current = parents[current]) {
+            BVHNode& node = nodes[current];
+            AABB bounds;
+            if (node.isLeaf()) {
+                for (uint32_t j = node.leftOrFirst; j < node.leftOrFirst + node.count; ++j) {
+                    bounds.expand(primBounds[primIndices[j]]);
+                }
+            } else {
+                bounds = nodes[node.leftOrFirst].bounds;
+                bounds.expand(nodes[node.leftOrFirst + 1].bounds);
+            }
+            if (bounds.min == node.bounds.min && bounds.max == node.bounds.max) {
+                break;
+            }
+            costSum -= nodeCost(node);
+            node.bounds = bounds;
+            costSum += nodeCost(node);
+        }
+    }
+}
+
+float BVH::sahCost() const {
+    if (nodes.empty()) {
+        return 0.0f;
+    }
+    float rootArea = nodes[0].bounds.surfaceArea();
+    return rootArea > 0.0f ? static_cast<float>(costSum / rootArea) : 0.0f;
+}
+
+void BVH::subdivide(uint32_t nodeIndex, const std::vector<AABB>& primBounds, std::vector<glm::vec3>& centroids, uint32_t maxLeafSize, int depth) {
+    uint32_t first = nodes[nodeIndex].leftOrFirst;
+    uint32_t count = nodes[nodeIndex].count;
+
+    AABB bounds;
+    AABB centroidBounds;
+    for (uint32_t i = first; i < first + count; ++i) {
+        bounds.expand(primBounds[primIndices[i]]);
+        centroidBounds.expand(centroids[primIndices[i]]);
+    }
+    nodes[nodeIndex].bounds = bounds;
+
+    if (count <= maxLeafSize || depth >= MAX_DEPTH) {
+        return;
+    }
+
+    // Busca el mejor corte por SAH en los tres ejes
+    float bestCost = std::numeric_limits<float>::infinity();
+    int bestAxis = -1;
+    int bestSplit = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        float lo = centroidBounds.min[axis];
+        float hi = centroidBounds.max[axis];
+        if (hi <= lo) {
+            continue;
+        }
+
+        Bin bins[BIN_COUNT];
+        float scale = BIN_COUNT / (hi - lo);
+        for (uint32_t i = first; i < first + count; ++i) {
+            int b = std::min(BIN_COUNT - 1, static_cast<int>((centroids[primIndices[i]][axis] - lo) * scale));
+            bins[b].count++;
+            bins[b].bounds.expand(primBounds[primIndices[i]]);
+        }
+
+        // Barrido de izquierda a derecha y de derecha a izquierda
+        float leftArea[BIN_COUNT - 1];
+        uint32_t leftCount[BIN_COUNT - 1];
+        AABB leftBox;
+        uint32_t leftSum = 0;
+        for (int b = 0; b < BIN_COUNT - 1; ++b) {
+            leftBox.expand(bins[b].bounds);
+            leftSum += bins[b].count;
+            leftArea[b] = leftBox.surfaceArea();
+            leftCount[b] = leftSum;
+        }
+        AABB rightBox;
+        uint32_t rightSum = 0;
+        for (int b = BIN_COUNT - 1; b > 0; --b) {
+            rightBox.expand(bins[b].bounds);
+            rightSum += bins[b].count;
+            float cost = leftArea[b - 1] * leftCount[b - 1] + rightBox.surfaceArea() * rightSum;
+            if (leftCount[b - 1] > 0 && rightSum > 0 && cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // Si partir no es mas barato que probar todos los primitivos, se queda como hoja
+    float leafCost = bounds.surfaceArea() * count;
+    if (bestAxis < 0 || bestCost >= leafCost) {
+        return;
+    }
+
+    float lo = centroidBounds.min[bestAxis];
+    float scale = BIN_COUNT / (centroidBounds.max[bestAxis] - lo);
+    uint32_t* begin = primIndices.data() + first;
+    uint32_t* middle = std::partition(begin, begin + count, [&](uint32_t prim) {
+        int b = std::min(BIN_COUNT - 1, static_cast<int>((centroids[prim][bestAxis] - lo) * scale));
+        return b < bestSplit;
+    });
+    uint32_t leftCount = static_cast<uint32_t>(middle - begin);
+    if (leftCount == 0 || leftCount == count) {
+        return;
+    }
+
+    uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(BVHNode{AABB(), first, leftCount});
+    nodes.push_back(BVHNode{AABB(), first + leftCount, count - leftCount});
+    nodes[nodeIndex].leftOrFirst = left;
+    nodes[nodeIndex].count = 0;
+
+    subdivide(left, primBounds, centroids, maxLeafSize, depth + 1);
+    subdivide(left + 1, primBounds, centroids, maxLeafSize, depth + 1);
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "aabb.h"
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+// Nodo de 32 bytes: dos nodos por linea de cache. Los hijos de un nodo interno
+// se guardan juntos (izquierdo en leftOrFirst, derecho en leftOrFirst + 1).
+struct BVHNode {
+    AABB bounds;
+    uint32_t leftOrFirst;  // nodo interno: hijo izquierdo; hoja: primer primitivo
+    uint32_t count;        // 0 para nodos internos
+
+    bool isLeaf() const { return count > 0; }
+};
+
+class BVH {
+public:
+    // Construye el arbol con SAH por bins a partir de las cajas de cada primitivo.
+    // Los nodos con maxLeafSize primitivos o menos quedan como hojas.
+    void build(const std::vector<AABB>& primBounds, uint32_t maxLeafSize = 4);
+
+    bool empty() const { return nodes.empty(); }
+    size_t nodeCount() const { return nodes.size(); }
+    // Caja de todos los primitivos; solo si no esta vacio
+    const AABB& rootBounds() const { return nodes[0].bounds; }
+
+    // Primitivos en el orden de las hojas: cada hoja es un rango contiguo de este arreglo
+    const std::vector<uint32_t>& leafOrder() const { return primIndices; }
+
+    // Vuelve a calcular las cajas de las hojas con los primitivos 'changed' y de sus ancestros
+    // hasta donde dejan de cambiar. La forma del arbol no cambia: si los primitivos se alejan
+    // mucho de donde estaban al construirlo, las cajas crecen y conviene volver a build().
+    void refit(const std::vector<AABB>& primBounds, const std::vector<uint32_t>& changed);
+
+    // Costo SAH del arbol: suma del area de cada nodo por el costo de visitarlo (1 por nodo
+    // interno, 1 por primitivo en las hojas), dividida por el area de la raiz
+    float sahCost() const;
+
+    // Recorre el arbol de cerca a lejos. visit(prim, tMax) prueba el primitivo
+    // y reduce tMax cuando encuentra un corte mas cercano.
+    template <typename Visit>
+    void traverse(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& tMax, Visit&& visit) const {
+        traverseLeaves(rayOrigin, rayDirection, tMax, [&](uint32_t first, uint32_t count, float& t) {
+            for (uint32_t i = first; i < first + count; ++i) {
+                visit(primIndices[i], t);
+            }
+        });
+    }
+
+    // Igual que traverse, pero visitLeaf(first, count, tMax) recibe la hoja completa
+    // como rango de leafOrder() para probar sus primitivos de una vez.
+    template <typename VisitLeaf>
+    void traverseLeaves(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& tMax, VisitLeaf&& visitLeaf) const {
+        walkLeaves(rayOrigin, rayDirection, tMax, [&](uint32_t first, uint32_t count, float& t) {
+            visitLeaf(first, count, t);
+            return false;
+        });
+    }
+
+    // Consulta de oclusion: visitLeaf(first, count, tMax) devuelve true en cuanto encuentra
+    // un bloqueador y el recorrido termina ahi. Devuelve si alguna hoja lo encontro.
+    template <typename VisitLeaf>
+    bool traverseAny(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax, VisitLeaf&& visitLeaf) const {
+        return walkLeaves(rayOrigin, rayDirection, tMax, visitLeaf);
+    }
+
+    // Recorre el arbol una sola vez para un paquete de hasta 64 rayos con origen comun.
+    // El bit i de 'active' marca el rayo i; tMax[i] es su distancia limite.
+    // visitLeaf(first, count, mask, tMax) recibe la hoja y los rayos del paquete que la alcanzan.
+    template <typename VisitLeaf>
+    void traversePacket(const glm::vec3& rayOrigin, const glm::vec3* invDirs, uint64_t active, float* tMax, VisitLeaf&& visitLeaf) const {
+        if (nodes.empty() || active == 0) {
+            return;
+        }
+        // El orden de los hijos se decide con la direccion del primer rayo
+        glm::vec3 leadDir = 1.0f / invDirs[std::countr_zero(active)];
+        PacketInterval interval = packetInterval(invDirs, active, tMax);
+
+        uint32_t stack[64];
+        uint64_t stackMasks[64];
+        int stackSize = 0;
+        uint32_t current = 0;
+        uint64_t mask = packetMask(nodes[0].bounds, rayOrigin, invDirs, interval, active, tMax);
+
+        while (true) {
+            if (mask != 0) {
+                const BVHNode& node = nodes[current];
+                if (node.isLeaf()) {
+                    visitLeaf(node.leftOrFirst, node.count, mask, tMax);
+                } else {
+                    uint32_t left = node.leftOrFirst;
+                    uint32_t right = left + 1;
+                    if (glm::dot(nodes[right].bounds.centroid() - nodes[left].bounds.centroid(), leadDir) < 0.0f) {
+                        std::swap(left, right);
+                    }
+                    uint64_t leftMask = packetMask(nodes[left].bounds, rayOrigin, invDirs, interval, mask, tMax);
+                    uint64_t rightMask = packetMask(nodes[right].bounds, rayOrigin, invDirs, interval, mask, tMax);
+                    if (leftMask != 0) {
+                        if (rightMask != 0) {
+                            stack[stackSize] = right;
+                            stackMasks[stackSize++] = rightMask;
+                        }
+                        current = left;
+                        mask = leftMask;
+                        continue;
+                    }
+                    if (rightMask != 0) {
+                        current = right;
+                        mask = rightMask;
+                        continue;
+                    }
+                }
+            }
+
+            if (stackSize == 0) {
+                return;
+            }
+            // Los rayos que ya encontraron un corte mas cercano se descartan al sacar el nodo
+            --stackSize;
+            current = stack[stackSize];
+            mask = packetMask(nodes[current].bounds, rayOrigin, invDirs, interval, stackMasks[stackSize], tMax);
+        }
+    }
+
+private:
+    // Recorrido de cerca a lejos comun a traverseLeaves y traverseAny; termina cuando
+    // visitLeaf devuelve true y en ese caso devuelve true
+    template <typename VisitLeaf>
+    bool walkLeaves(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& tMax, VisitLeaf&& visitLeaf) const {
+        if (nodes.empty()) {
+            return false;
+        }
+        glm::vec3 invDir = 1.0f / rayDirection;
+        if (nodes[0].bounds.rayEntry(rayOrigin, invDir, tMax) == std::numeric_limits<float>::infinity()) {
+            return false;
+        }
+
+        uint32_t stack[64];
+        int stackSize = 0;
+        uint32_t current = 0;
+
+        while (true) {
+            const BVHNode& node = nodes[current];
+            if (node.isLeaf()) {
+                if (visitLeaf(node.leftOrFirst, node.count, tMax)) {
+                    return true;
+                }
+            } else {
+                uint32_t left = node.leftOrFirst;
+                uint32_t right = left + 1;
+                float tLeft = nodes[left].bounds.rayEntry(rayOrigin, invDir, tMax);
+                float tRight = nodes[right].bounds.rayEntry(rayOrigin, invDir, tMax);
+                if (tLeft > tRight) {
+                    std::swap(tLeft, tRight);
+                    std::swap(left, right);
+                }
+                if (tLeft != std::numeric_limits<float>::infinity()) {
+                    if (tRight != std::numeric_limits<float>::infinity()) {
+                        stack[stackSize++] = right;
+                    }
+                    current = left;
+                    continue;
+                }
+            }
+
+            // Saca el siguiente nodo que aun puede estar antes de tMax
+            bool found = false;
+            while (stackSize > 0) {
+                current = stack[--stackSize];
+                if (nodes[current].bounds.rayEntry(rayOrigin, invDir, tMax) != std::numeric_limits<float>::infinity()) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+
+    // Rango de 1/direccion de todo el paquete por eje, para descartar un nodo con una sola
+    // prueba cuando ningun rayo puede golpearlo. Un eje con signos mezclados o 1/0 no acota.
+    struct PacketInterval {
+        glm::vec3 invLo;
+        glm::vec3 invHi;
+        bool bounded[3];
+        float tMax;
+    };
+
+    static PacketInterval packetInterval(const glm::vec3* invDirs, uint64_t mask, const float* tMax) {
+        PacketInterval interval{glm::vec3(std::numeric_limits<float>::infinity()), glm::vec3(-std::numeric_limits<float>::infinity()),
+                                {true, true, true}, 0.0f};
+        for (; mask != 0; mask &= mask - 1) {
+            int lane = std::countr_zero(mask);
+            interval.invLo = glm::min(interval.invLo, invDirs[lane]);
+            interval.invHi = glm::max(interval.invHi, invDirs[lane]);
+            interval.tMax = std::max(interval.tMax, tMax[lane]);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            interval.bounded[axis] = std::isfinite(interval.invLo[axis]) && std::isfinite(interval.invHi[axis]) &&
+                                     (interval.invLo[axis] > 0.0f || interval.invHi[axis] < 0.0f);
+        }
+        return interval;
+    }
+
+    // Rayos de 'mask' que entran a la caja antes de su tMax
+    static uint64_t packetMask(const AABB& bounds, const glm::vec3& rayOrigin, const glm::vec3* invDirs,
+                               const PacketInterval& interval, uint64_t mask, const float* tMax) {
+        // Cota de todo el paquete: entrada minima posible y salida maxima posible
+        float tNear = 0.0f;
+        float tFar = interval.tMax;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (!interval.bounded[axis]) {
+                continue;
+            }
+            float lo = bounds.min[axis] - rayOrigin[axis];
+            float hi = bounds.max[axis] - rayOrigin[axis];
+            float a = lo * interval.invLo[axis], b = lo * interval.invHi[axis];
+            float c = hi * interval.invLo[axis], d = hi * interval.invHi[axis];
+            tNear = std::max(tNear, std::min(std::min(a, b), std::min(c, d)));
+            tFar = std::min(tFar, std::max(std::max(a, b), std::max(c, d)));
+        }
+        if (tNear > tFar) {
+            return 0;
+        }
+
+        uint64_t result = 0;
+        for (; mask != 0; mask &= mask - 1) {
+            int lane = std::countr_zero(mask);
+            if (bounds.rayEntry(rayOrigin, invDirs[lane], tMax[lane]) != std::numeric_limits<float>::infinity()) {
+                result |= uint64_t(1) << lane;
+            }
+        }
+        return result;
+    }
+
+    void subdivide(uint32_t nodeIndex, const std::vector<AABB>& primBounds, std::vector<glm::vec3>& centroids, uint32_t maxLeafSize, int depth);
+    float nodeCost(const BVHNode& node) const { return node.bounds.surfaceArea() * (node.isLeaf() ? node.count : 1); }
+
+    std::vector<BVHNode> nodes;
+    std::vector<uint32_t> primIndices;
+
+    // Para refit(): padre de cada nodo, hoja de cada primitivo y suma de nodeCost()
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> leafOfPrim;
+    double costSum = 0.0;
+};
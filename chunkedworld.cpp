@@ -0,0 +1,283 @@
+#include "chunkedworld.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+
+namespace {
+    const char MAGIC[8] = {'P', '3', 'W', 'O', 'R', 'L', 'D', '\0'};
+    const uint32_t VERSION = 1;
+    const uint64_t CHUNK_ALIGNMENT = 4096;
+    // El escritor arma la tabla densa en memoria: 2^26 posiciones son 512 MB
+    const uint64_t MAX_TABLE_SLOTS = uint64_t(1) << 26;
+
+    // Chunks que updateResidency() pide alrededor de la camara, y angulo del cono de vista
+    const int PREFETCH_RADIUS = 4;
+    const float PREFETCH_COS = 0.5f;
+
+    struct WorldHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t chunkSize;
+        int32_t chunkOrigin[3];
+        int32_t chunkDims[3];
+        int32_t minCell[3];
+        int32_t maxCell[3];
+        uint64_t solidCount;
+        uint64_t offsetsOffset;  // tabla de chunkDims.x * chunkDims.y * chunkDims.z posiciones
+    };
+
+    uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    size_t slotOf(const glm::ivec3& c, const glm::ivec3& dims) {
+        return (static_cast<size_t>(c.z) * dims.y + c.y) * dims.x + c.x;
+    }
+
+    // Sin negar 'a', que para INT_MIN daria la vuelta
+    int floorDiv(int a, int b) {
+        return (a >= 0) ? a / b : -1 - (-(a + 1)) / b;
+    }
+}
+
+ChunkedWorld::~ChunkedWorld() {
+    std::free(stamps);
+}
+
+bool ChunkedWorld::open(const std::string& file) {
+    if (!mapped.open(file)) {
+        return false;
+    }
+
+    WorldHeader header;
+    if (mapped.size() < sizeof(header) || std::memcmp(mapped.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << file << ": not a world file" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (header.version != VERSION || header.chunkSize != CHUNK_SIZE) {
+        std::cerr << file << ": unsupported world version " << header.version << std::endl;
+        return false;
+    }
+
+    chunkOrigin = glm::ivec3(header.chunkOrigin[0], header.chunkOrigin[1], header.chunkOrigin[2]);
+    chunkDims = glm::ivec3(header.chunkDims[0], header.chunkDims[1], header.chunkDims[2]);
+    if (glm::any(glm::lessThan(chunkDims, glm::ivec3(0))) || header.offsetsOffset % alignof(uint64_t) != 0 ||
+        header.offsetsOffset > mapped.size()) {
+        std::cerr << file << ": chunk table out of bounds" << std::endl;
+        return false;
+    }
+    // Con el origen y el final dentro del rango de chunks de una celda int, chunk - chunkOrigin
+    // en find() no se desborda
+    const int64_t chunkLimit = std::numeric_limits<int32_t>::max() / CHUNK_SIZE + 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        int64_t from = chunkOrigin[axis];
+        int64_t to = from + chunkDims[axis];
+        if (from < -chunkLimit || to > chunkLimit) {
+            std::cerr << file << ": chunk table out of bounds" << std::endl;
+            return false;
+        }
+    }
+    // El producto de las dimensiones se acota antes de cada multiplicacion para que no de la vuelta
+    size_t capacity = static_cast<size_t>((mapped.size() - header.offsetsOffset) / sizeof(uint64_t));
+    size_t slots = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        size_t dim = static_cast<size_t>(chunkDims[axis]);
+        if (dim != 0 && slots > capacity / dim) {
+            std::cerr << file << ": chunk table out of bounds" << std::endl;
+            return false;
+        }
+        slots *= dim;
+    }
+    offsets = reinterpret_cast<const uint64_t*>(mapped.data() + header.offsetsOffset);
+
+    // Las posiciones de los chunks se validan en find(); recorrer la tabla aqui costaria un
+    // acceso por chunk del mundo
+    minCell = glm::ivec3(header.minCell[0], header.minCell[1], header.minCell[2]);
+    maxCell = glm::ivec3(header.maxCell[0], header.maxCell[1], header.maxCell[2]);
+    solidCount = static_cast<size_t>(header.solidCount);
+
+    std::free(stamps);
+    stamps = static_cast<uint32_t*>(std::calloc(std::max<size_t>(slots, 1), sizeof(uint32_t)));
+    resident.clear();
+    touched.clear();
+    return stamps != nullptr;
+}
+
+const MaterialId* ChunkedWorld::find(const glm::ivec3& chunk) const {
+    glm::ivec3 c = chunk - chunkOrigin;
+    if (c.x < 0 || c.y < 0 || c.z < 0 || c.x >= chunkDims.x || c.y >= chunkDims.y || c.z >= chunkDims.z) {
+        return nullptr;
+    }
+    size_t slot = slotOf(c, chunkDims);
+    uint64_t offset = offsets[slot];
+    if (offset == 0 || offset % CHUNK_ALIGNMENT != 0 || offset > mapped.size() || mapped.size() - offset < CHUNK_BYTES) {
+        return nullptr;
+    }
+
+    // Solo el primer uso de un chunk en el cuadro escribe; la primera vez que se vuelve
+    // residente ademas se anota para el LRU
+    std::atomic_ref<uint32_t> stamp(stamps[slot]);
+    uint32_t now = frame.load(std::memory_order_relaxed);
+    if (stamp.load(std::memory_order_relaxed) != now && stamp.exchange(now, std::memory_order_relaxed) == 0) {
+        std::lock_guard<std::mutex> lock(touchedMutex);
+        touched.push_back(static_cast<uint32_t>(slot));
+    }
+    return reinterpret_cast<const MaterialId*>(mapped.data() + offset);
+}
+
+void ChunkedWorld::updateResidency(const glm::vec3& eye, const glm::vec3& forward) {
+    frame.store(frame.load() + 1);
+
+    // Chunks cercanos en el cono de vista; los vecinos inmediatos se piden siempre
+    glm::ivec3 center = chunkOf(glm::ivec3(glm::floor(eye + 0.5f)));
+    const float maxDistance = static_cast<float>(PREFETCH_RADIUS * CHUNK_SIZE);
+    for (int z = -PREFETCH_RADIUS; z <= PREFETCH_RADIUS; z++) {
+        for (int y = -PREFETCH_RADIUS; y <= PREFETCH_RADIUS; y++) {
+            for (int x = -PREFETCH_RADIUS; x <= PREFETCH_RADIUS; x++) {
+                glm::ivec3 chunk = center + glm::ivec3(x, y, z);
+                glm::vec3 middle = glm::vec3(chunk * CHUNK_SIZE) + (CHUNK_SIZE - 1) * 0.5f;
+                glm::vec3 toChunk = middle - eye;
+                float distance = glm::length(toChunk);
+                if (distance > maxDistance || (distance > CHUNK_SIZE && glm::dot(toChunk, forward) < PREFETCH_COS * distance)) {
+                    continue;
+                }
+                if (const MaterialId* cells = find(chunk)) {
+                    mapped.prefetch(reinterpret_cast<const uint8_t*>(cells) - mapped.data(), CHUNK_BYTES);
+                }
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(touchedMutex);
+        resident.insert(resident.end(), touched.begin(), touched.end());
+        touched.clear();
+    }
+    if (resident.size() <= budget) {
+        return;
+    }
+
+    // LRU: se quedan los 'budget' usados mas recientemente
+    std::nth_element(resident.begin(), resident.begin() + budget, resident.end(),
+                     [&](uint32_t a, uint32_t b) { return stamps[a] > stamps[b]; });
+    for (size_t i = budget; i < resident.size(); i++) {
+        uint32_t slot = resident[i];
+        mapped.release(offsets[slot], CHUNK_BYTES);
+        stamps[slot] = 0;
+    }
+    resident.resize(budget);
+}
+
+glm::ivec3 ChunkedWorld::chunkOf(const glm::ivec3& cell) {
+    return glm::ivec3(floorDiv(cell.x, CHUNK_SIZE), floorDiv(cell.y, CHUNK_SIZE), floorDiv(cell.z, CHUNK_SIZE));
+}
+
+bool ChunkedWorldWriter::open(const std::string& file, const glm::ivec3& fromChunk, const glm::ivec3& toChunk) {
+    this->file = file;
+
+    // Los mismos limites que valida ChunkedWorld::open, antes de crear el archivo
+    const int64_t chunkLimit = std::numeric_limits<int32_t>::max() / ChunkedWorld::CHUNK_SIZE + 1;
+    uint64_t slots = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        int64_t from = std::min(fromChunk[axis], toChunk[axis]);
+        int64_t to = int64_t(std::max(fromChunk[axis], toChunk[axis])) + 1;
+        slots *= static_cast<uint64_t>(to - from);
+        if (from < -chunkLimit || to > chunkLimit || slots > MAX_TABLE_SLOTS) {
+            std::cerr << file << ": world too large for the chunk table" << std::endl;
+            return false;
+        }
+    }
+
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot open " << file << " for writing" << std::endl;
+        return false;
+    }
+    chunkOrigin = glm::min(fromChunk, toChunk);
+    chunkDims = glm::max(fromChunk, toChunk) - chunkOrigin + 1;
+    offsets.assign(static_cast<size_t>(slots), 0);
+    minCell = glm::ivec3(std::numeric_limits<int>::max());
+    maxCell = glm::ivec3(std::numeric_limits<int>::min());
+    solidCount = 0;
+
+    // La cabecera y la tabla se escriben al cerrar; los chunks empiezan despues
+    end = alignUp(alignUp(sizeof(WorldHeader), alignof(uint64_t)) + offsets.size() * sizeof(uint64_t), CHUNK_ALIGNMENT);
+    return true;
+}
+
+bool ChunkedWorldWriter::add(const glm::ivec3& chunk, const MaterialId* cells) {
+    glm::ivec3 c = chunk - chunkOrigin;
+    if (c.x < 0 || c.y < 0 || c.z < 0 || c.x >= chunkDims.x || c.y >= chunkDims.y || c.z >= chunkDims.z) {
+        std::cerr << file << ": chunk outside the world bounds" << std::endl;
+        return discard();
+    }
+
+    uint64_t& offset = offsets[slotOf(c, chunkDims)];
+    if (offset != 0) {
+        std::cerr << file << ": chunk added twice" << std::endl;
+        return discard();
+    }
+
+    size_t solid = 0;
+    for (int i = 0; i < ChunkedWorld::CHUNK_CELLS; i++) {
+        if (cells[i] != 0) {
+            solid++;
+            glm::ivec3 cell = chunk * ChunkedWorld::CHUNK_SIZE +
+                              glm::ivec3(i % ChunkedWorld::CHUNK_SIZE, (i / ChunkedWorld::CHUNK_SIZE) % ChunkedWorld::CHUNK_SIZE,
+                                         i / (ChunkedWorld::CHUNK_SIZE * ChunkedWorld::CHUNK_SIZE));
+            minCell = glm::min(minCell, cell);
+            maxCell = glm::max(maxCell, cell);
+        }
+    }
+    if (solid == 0) {
+        return true;
+    }
+
+    offset = end;
+    out.seekp(static_cast<std::streamoff>(end));
+    out.write(reinterpret_cast<const char*>(cells), ChunkedWorld::CHUNK_BYTES);
+    end += ChunkedWorld::CHUNK_BYTES;
+    solidCount += solid;
+    if (!out) {
+        std::cerr << "Failed writing " << file << std::endl;
+        return discard();
+    }
+    return true;
+}
+
+bool ChunkedWorldWriter::close() {
+    WorldHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.chunkSize = ChunkedWorld::CHUNK_SIZE;
+    for (int i = 0; i < 3; i++) {
+        header.chunkOrigin[i] = chunkOrigin[i];
+        header.chunkDims[i] = chunkDims[i];
+        header.minCell[i] = solidCount > 0 ? minCell[i] : 0;
+        header.maxCell[i] = solidCount > 0 ? maxCell[i] : -1;
+    }
+    header.solidCount = solidCount;
+    header.offsetsOffset = alignUp(sizeof(WorldHeader), alignof(uint64_t));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.seekp(static_cast<std::streamoff>(header.offsetsOffset));
+    out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+    out.close();
+    if (!out) {
+        std::cerr << "Failed writing " << file << std::endl;
+        return discard();
+    }
+    return true;
+}
+
+bool ChunkedWorldWriter::discard() {
+    out.close();
+    std::error_code error;
+    std::filesystem::remove(file, error);
+    return false;
+}
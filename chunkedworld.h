@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+#include "material.h"
+#include "mappedfile.h"
+
+// Mundo de bloques por chunks en disco (.world), para mallas mas grandes que la memoria.
+// El archivo tiene una cabecera, una tabla densa con la posicion de cada chunk dentro de
+// los limites (0 = vacio) y los chunks no vacios, cada uno con los 16x16x16 valores de sus
+// celdas en el mismo orden que VoxelGrid y alineado a 4096 bytes. Un valor v > 0 es el
+// material v - 1 de la escena que carga el mundo; 0 es aire.
+//
+// El archivo se proyecta en memoria, asi que abrirlo no lee ningun chunk: el sistema trae cada
+// uno la primera vez que un rayo lo toca. updateResidency() pide por adelantado los chunks en
+// el cono de vista y suelta los que llevan mas cuadros sin usarse cuando pasan del presupuesto.
+class ChunkedWorld {
+public:
+    static const int CHUNK_SIZE = 16;
+    static const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+    static const size_t CHUNK_BYTES = CHUNK_CELLS * sizeof(MaterialId);
+
+    // Chunk que contiene una celda, redondeando hacia abajo tambien en negativos
+    static glm::ivec3 chunkOf(const glm::ivec3& cell);
+
+    ChunkedWorld() = default;
+    ~ChunkedWorld();
+
+    ChunkedWorld(const ChunkedWorld&) = delete;
+    ChunkedWorld& operator=(const ChunkedWorld&) = delete;
+
+    // Solo lee la cabecera y valida la tabla; el costo no depende del tamaño del mundo
+    bool open(const std::string& file);
+
+    // Celdas de un chunk, o nullptr si esta vacio o fuera del mundo. Lo llaman los hilos al
+    // recorrer la malla; marca el chunk como usado en el cuadro actual.
+    const MaterialId* find(const glm::ivec3& chunk) const;
+
+    const glm::ivec3& getMinCell() const { return minCell; }
+    const glm::ivec3& getMaxCell() const { return maxCell; }
+    size_t getSolidCount() const { return solidCount; }
+
+    // Cuadro nuevo, con los hilos quietos: pide los chunks cercanos en el cono de vista y, si hay
+    // mas de 'budget' residentes, suelta los de uso mas viejo
+    void updateResidency(const glm::vec3& eye, const glm::vec3& forward);
+    void setBudget(size_t chunks) { budget = chunks; }
+    size_t getBudget() const { return budget; }
+    size_t residentCount() const { return resident.size(); }
+
+private:
+    MappedFile mapped;
+    const uint64_t* offsets = nullptr;
+    glm::ivec3 chunkOrigin = glm::ivec3(0);
+    glm::ivec3 chunkDims = glm::ivec3(0);
+    glm::ivec3 minCell = glm::ivec3(0);
+    glm::ivec3 maxCell = glm::ivec3(-1);
+    size_t solidCount = 0;
+
+    // Cuadro en que se uso por ultima vez cada chunk (0 = no residente). Se reserva con calloc
+    // para que las paginas en cero no cuesten nada hasta tocarlas.
+    uint32_t* stamps = nullptr;
+    std::atomic<uint32_t> frame{1};
+    size_t budget = 32768;  // 256 MB de chunks
+
+    std::vector<uint32_t> resident;          // chunks con stamp != 0
+    mutable std::mutex touchedMutex;
+    mutable std::vector<uint32_t> touched;   // se volvieron residentes durante el cuadro
+};
+
+// Escribe un .world chunk por chunk, sin tener el mundo entero en memoria
+class ChunkedWorldWriter {
+public:
+    // El mundo cubre los chunks [fromChunk, toChunk]. Falla sin crear el archivo si la tabla no
+    // cabe en el formato; si luego falla add() o close(), el archivo a medio escribir se borra.
+    bool open(const std::string& file, const glm::ivec3& fromChunk, const glm::ivec3& toChunk);
+    // 'cells' tiene ChunkedWorld::CHUNK_CELLS valores; los chunks vacios no ocupan lugar
+    bool add(const glm::ivec3& chunk, const MaterialId* cells);
+    bool close();
+
+private:
+    bool discard();
+
+    std::string file;
+    std::ofstream out;
+    std::vector<uint64_t> offsets;
+    glm::ivec3 chunkOrigin = glm::ivec3(0);
+    glm::ivec3 chunkDims = glm::ivec3(0);
+    glm::ivec3 minCell = glm::ivec3(std::numeric_limits<int>::max());
+    glm::ivec3 maxCell = glm::ivec3(std::numeric_limits<int>::min());
+    uint64_t solidCount = 0;
+    uint64_t end = 0;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+// Lee un numero de la linea de comandos. Falla si el texto no es un numero completo o si el valor
+// queda fuera de [minValue, maxValue]; en ese caso 'value' no cambia.
+template <typename T>
+bool parseArg(const char* text, T minValue, T maxValue, T& value) {
+    const char* end = text + std::strlen(text);
+    T parsed;
+    auto [last, error] = std::from_chars(text, end, parsed);
+    // Escrito asi para que NaN tambien quede fuera del rango
+    if (error != std::errc() || last != end || !(parsed >= minValue && parsed <= maxValue)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
@@ -1,32 +1,33 @@
 #pragma once
-#include <SDL.h>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 struct Color {
-    Uint8 r;
-    Uint8 g;
-    Uint8 b;
-    Uint8 a;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
     int i = 0;
 
     Color() : r(0), g(0), b(0), a(255) {}
 
     Color(int red, int green, int blue, int alpha = 255) {
-        r = static_cast<Uint8>(std::min(std::max(red, 0), 255));
-        g = static_cast<Uint8>(std::min(std::max(green, 0), 255));
-        b = static_cast<Uint8>(std::min(std::max(blue, 0), 255));
-        a = static_cast<Uint8>(std::min(std::max(alpha, 0), 255));
+        r = static_cast<uint8_t>(std::min(std::max(red, 0), 255));
+        g = static_cast<uint8_t>(std::min(std::max(green, 0), 255));
+        b = static_cast<uint8_t>(std::min(std::max(blue, 0), 255));
+        a = static_cast<uint8_t>(std::min(std::max(alpha, 0), 255));
     }
 
     Color(float red, float green, float blue, float alpha = 1.0f) {
-        r = std::clamp(static_cast<Uint8>(red * 255), Uint8(0), Uint8(255));
-        g = std::clamp(static_cast<Uint8>(green * 255), Uint8(0), Uint8(255));
-        b = std::clamp(static_cast<Uint8>(blue * 255), Uint8(0), Uint8(255));
-        a = std::clamp(static_cast<Uint8>(alpha * 255), Uint8(0), Uint8(255));
+        r = std::clamp(static_cast<uint8_t>(red * 255), uint8_t(0), uint8_t(255));
+        g = std::clamp(static_cast<uint8_t>(green * 255), uint8_t(0), uint8_t(255));
+        b = std::clamp(static_cast<uint8_t>(blue * 255), uint8_t(0), uint8_t(255));
+        a = std::clamp(static_cast<uint8_t>(alpha * 255), uint8_t(0), uint8_t(255));
     }
 
-    Color(char* none) {
+    // Centinela de "sin corte": negro para que sumarlo como reflejo no lea basura
+    Color(char* none) : r(0), g(0), b(0), a(0) {
         i = 1;
     }
 
@@ -43,19 +44,19 @@ struct Color {
     // Overload the * operator to scale colors by a factor
     Color operator*(float factor) const {
         return Color(
-            std::clamp(static_cast<Uint8>(r * factor), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(g * factor), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(b * factor), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(a * factor), Uint8(0), Uint8(255))
+            std::clamp(static_cast<uint8_t>(r * factor), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(g * factor), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(b * factor), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(a * factor), uint8_t(0), uint8_t(255))
         );
     }
 
     Color operator*(Color color) const {
         return Color(
-            std::clamp(static_cast<Uint8>(r * color.r), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(g * color.g), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(b * color.b), Uint8(0), Uint8(255)),
-            std::clamp(static_cast<Uint8>(a * color.a), Uint8(0), Uint8(255))
+            std::clamp(static_cast<uint8_t>(r * color.r), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(g * color.g), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(b * color.b), uint8_t(0), uint8_t(255)),
+            std::clamp(static_cast<uint8_t>(a * color.a), uint8_t(0), uint8_t(255))
         );
     };
 
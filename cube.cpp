@@ -1,18 +1,18 @@
 #include "cube.h"
 
-Cube::Cube(const glm::vec3& center, float size, const Material& mat)
+Cube::Cube(const glm::vec3& center, float size, MaterialId mat)
         : center(center), size(size), Object(mat) {
 }
 
-Intersect Cube::rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const {
-    glm::vec3 oc = rayOrigin - center;
+bool Cube::rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const {
     float tMin = -std::numeric_limits<float>::infinity();
     float tMax = std::numeric_limits<float>::infinity();
+    const float half = size / 2.0f;
+    const glm::vec3 invDir = 1.0f / rayDirection;
 
     for (int i = 0; i < 3; ++i) {
-        float invDir = 1.0f / rayDirection[i];
-        float tNear = (center[i] - size / 2.0f - rayOrigin[i]) * invDir;
-        float tFar = (center[i] + size / 2.0f - rayOrigin[i]) * invDir;
+        float tNear = (center[i] - half - rayOrigin[i]) * invDir[i];
+        float tFar = (center[i] + half - rayOrigin[i]) * invDir[i];
 
         if (tNear > tFar) {
             std::swap(tNear, tFar);
@@ -22,19 +22,33 @@ Intersect Cube::rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDir
         tMax = std::min(tFar, tMax);
 
         if (tMin > tMax) {
-            return Intersect{false, 0};
+            return false;
         }
     }
 
-    float tHit = (tMin > 0.0f) ? tMin : tMax;
+    // El cubo queda completamente detras del origen del rayo
+    if (tMax < 0.0f) {
+        return false;
+    }
+
+    // Si el origen esta dentro del cubo el corte es la salida
+    t = (tMin > 0.0f) ? tMin : tMax;
+    return true;
+}
 
-    glm::vec3 point = rayOrigin + tHit * rayDirection;
+Intersect Cube::surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const {
+    return surface(center, size, rayOrigin, rayDirection, t);
+}
+
+Intersect Cube::surface(const glm::vec3& center, float size, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) {
+    const float half = size / 2.0f;
+    glm::vec3 point = rayOrigin + t * rayDirection;
     glm::vec3 normal(0.0f);
 
     for (int i = 0; i < 3; ++i) {
-        if (point[i] < center[i] - size / 2.0f + 0.001f) {
+        if (point[i] < center[i] - half + 0.001f) {
             normal[i] = -1.0f;
-        } else if (point[i] > center[i] + size / 2.0f - 0.001f) {
+        } else if (point[i] > center[i] + half - 0.001f) {
             normal[i] = 1.0f;
         }
     }
@@ -43,8 +57,7 @@ Intersect Cube::rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDir
     float tx, ty;
 
     // Proyecta las coordenadas del punto de intersección en cada cara del cubo sobre un plano 2D
-    glm::vec3 hitPoint = rayOrigin + tHit * rayDirection;
-    glm::vec3 localHitPoint = hitPoint - center;
+    glm::vec3 localHitPoint = point - center;
 
     if (std::abs(normal.x) > 0) {
         tx = (localHitPoint.z / size) + 0.5f;
@@ -57,5 +70,10 @@ Intersect Cube::rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDir
         ty = (localHitPoint.y / size) + 0.5f;
     }
 
-    return Intersect{true, tHit, point, normal, tx, ty};
+    return Intersect{true, t, point, normal, tx, ty};
+}
+
+AABB Cube::getBounds() const {
+    glm::vec3 half(size / 2.0f);
+    return AABB{center - half, center + half};
 }
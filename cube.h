@@ -7,9 +7,23 @@
 
 class Cube : public Object {
 public:
-    Cube(const glm::vec3& center, float size, const Material& mat);
+    Cube(const glm::vec3& center, float size, MaterialId mat);
 
-    Intersect rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const override;
+    bool rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const override;
+
+    Intersect surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const override;
+
+    // Punto, normal y uv en la superficie de un cubo dado por centro y tamaño.
+    // La usan surfaceAt y los arreglos de cubos compilados de Scene.
+    static Intersect surface(const glm::vec3& center, float size, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t);
+
+    AABB getBounds() const override;
+
+    const glm::vec3& getCenter() const { return center; }
+    float getSize() const { return size; }
+
+    // Cubo de tamaño 1 centrado en coordenadas enteras: cabe exacto en una celda de VoxelGrid
+    bool isUnitVoxel() const { return size == 1.0f && center == glm::round(center); }
 
 private:
     glm::vec3 center;  // Se agregó el miembro 'center'
@@ -0,0 +1,66 @@
+#include "framebuffer.h"
+#include <algorithm>
+#include <cmath>
+
+Framebuffer::Framebuffer(int width, int height)
+        : width(width), height(height),
+          front(static_cast<size_t>(width) * height * 4, 0),
+          back(static_cast<size_t>(width) * height * 4, 0) {
+}
+
+void Framebuffer::swap() {
+    front.swap(back);
+    frontDirty = true;
+}
+
+void Framebuffer::upscaleFrom(const Framebuffer& source) {
+    const std::vector<uint8_t>& src = source.front;
+    const float scaleX = static_cast<float>(source.width) / width;
+    const float scaleY = static_cast<float>(source.height) / height;
+
+    // Columnas de la fuente y peso de cada una, iguales para todas las filas
+    std::vector<int> column0(width), column1(width);
+    std::vector<float> columnWeight(width);
+    for (int x = 0; x < width; x++) {
+        float sx = std::clamp((x + 0.5f) * scaleX - 0.5f, 0.0f, static_cast<float>(source.width - 1));
+        column0[x] = static_cast<int>(sx);
+        column1[x] = std::min(column0[x] + 1, source.width - 1);
+        columnWeight[x] = sx - column0[x];
+    }
+
+    for (int y = 0; y < height; y++) {
+        // Centro del pixel de destino en coordenadas de la fuente
+        float sy = std::clamp((y + 0.5f) * scaleY - 0.5f, 0.0f, static_cast<float>(source.height - 1));
+        int y0 = static_cast<int>(sy);
+        int y1 = std::min(y0 + 1, source.height - 1);
+        float fy = sy - y0;
+        const uint8_t* row0 = &src[static_cast<size_t>(y0) * source.width * 4];
+        const uint8_t* row1 = &src[static_cast<size_t>(y1) * source.width * 4];
+        uint8_t* p = &back[static_cast<size_t>(y) * width * 4];
+
+        for (int x = 0; x < width; x++, p += 4) {
+            float fx = columnWeight[x];
+            const uint8_t* taps[4] = {row0 + column0[x] * 4, row0 + column1[x] * 4, row1 + column0[x] * 4, row1 + column1[x] * 4};
+            const float weights[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+
+            float r = 0, g = 0, b = 0, a = 0;
+            for (int i = 0; i < 4; i++) {
+                float w = weights[i] * taps[i][3];
+                r += taps[i][0] * w;
+                g += taps[i][1] * w;
+                b += taps[i][2] * w;
+                a += w;
+            }
+
+            if (a <= 0.0f) {
+                p[0] = p[1] = p[2] = p[3] = 0;
+                continue;
+            }
+            float inverse = 1.0f / a;
+            p[0] = static_cast<uint8_t>(r * inverse + 0.5f);
+            p[1] = static_cast<uint8_t>(g * inverse + 0.5f);
+            p[2] = static_cast<uint8_t>(b * inverse + 0.5f);
+            p[3] = static_cast<uint8_t>(a + 0.5f);
+        }
+    }
+}
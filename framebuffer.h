@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "color.h"
+
+// Doble buffer RGBA8 en CPU. Los hilos escriben el buffer trasero; el frontend
+// sube el delantero (por ejemplo a una textura SDL_TEXTUREACCESS_STREAMING).
+class Framebuffer {
+public:
+    Framebuffer(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    void setPixel(int x, int y, const Color& color) {
+        setPixel(x, y, color, 255);
+    }
+
+    // Pixel cubierto en parte (bordes suavizados): el frontend lo mezcla con el fondo
+    void setPixel(int x, int y, const Color& color, uint8_t alpha) {
+        uint8_t* p = &back[(static_cast<size_t>(y) * width + x) * 4];
+        p[0] = color.r;
+        p[1] = color.g;
+        p[2] = color.b;
+        p[3] = alpha;
+    }
+
+    // Pixel sin objeto: transparente para que se vea el fondo
+    void clearPixel(int x, int y) {
+        uint8_t* p = &back[(static_cast<size_t>(y) * width + x) * 4];
+        p[0] = p[1] = p[2] = p[3] = 0;
+    }
+
+    // Llena el buffer trasero con el delantero de 'source' (de otro tamaño) con filtro bilineal.
+    // Interpola con alfa premultiplicado para que los bordes no se oscurezcan con los pixeles vacios.
+    void upscaleFrom(const Framebuffer& source);
+
+    // El cuadro recien trazado pasa a ser el delantero
+    void swap();
+    bool hasNewFrame() const { return frontDirty; }
+    // El frontend ya mostro el buffer delantero
+    void markPresented() { frontDirty = false; }
+    const std::vector<uint8_t>& frontPixels() const { return front; }
+
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> front;
+    std::vector<uint8_t> back;
+    bool frontDirty = false;
+};
@@ -0,0 +1,131 @@
+// Render sin ventana para servidores:
+//   Proyecto3_headless --out frame.png --width 1920 --height 1080 [--threads N] [--samples N] [--scene FILE]
+// El formato sale de la extension (.png, .ppm, .exr). No inicializa el video de SDL.
+// Sin SDL_image (RAYTRACER_SDL_IMAGE sin definir) no hay .png ni texturas: los materiales usan
+// su color difuso y la salida por defecto es frame.ppm.
+// Con --scene FILE --save-scene OUT.sceneb solo convierte la escena a la forma binaria;
+// --save-world OUT.world escribe sus bloques como mundo por chunks, y si tambien se pide
+// --save-scene esa escena usa el mundo en vez de los bloques.
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "cliargs.h"
+#include "scene.h"
+#include "scenefile.h"
+#include "house.h"
+#include "raytracer.h"
+#include "threadpool.h"
+#ifdef RAYTRACER_SDL_IMAGE
+#include "sdlimage.h"
+#endif
+
+namespace {
+#ifdef RAYTRACER_SDL_IMAGE
+    const ImageDecoder DECODER = decodeImageSDL;
+    const ImageEncoder PNG_ENCODER = encodePNGSDL;
+    const char* const DEFAULT_OUT = "frame.png";
+#else
+    const ImageDecoder DECODER = nullptr;
+    const ImageEncoder PNG_ENCODER = nullptr;
+    const char* const DEFAULT_OUT = "frame.ppm";
+#endif
+
+    const unsigned MAX_THREADS = 1024;
+    const int MAX_SIZE = 16384;
+    const int MAX_SAMPLES = 4096;
+
+    void printUsage() {
+        std::cerr << "usage: Proyecto3_headless [--out FILE] [--width N] [--height N] [--threads N] [--samples N]\n"
+                     "                          [--scene FILE] [--save-scene OUT.sceneb] [--save-world OUT.world]"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threadCount = 0;
+    std::string outFile = DEFAULT_OUT;
+    int width = 400;
+    int height = 300;
+    int samples = 1;
+    std::string sceneFile;
+    std::string saveFile;
+    std::string worldFile;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool valid = true;
+        if (arg == "--threads" && i + 1 < argc) {
+            valid = parseArg(argv[++i], 0u, MAX_THREADS, threadCount);
+        } else if (arg == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else if (arg == "--width" && i + 1 < argc) {
+            valid = parseArg(argv[++i], 1, MAX_SIZE, width);
+        } else if (arg == "--height" && i + 1 < argc) {
+            valid = parseArg(argv[++i], 1, MAX_SIZE, height);
+        } else if (arg == "--samples" && i + 1 < argc) {
+            valid = parseArg(argv[++i], 1, MAX_SAMPLES, samples);
+        } else if (arg == "--scene" && i + 1 < argc) {
+            sceneFile = argv[++i];
+        } else if (arg == "--save-scene" && i + 1 < argc) {
+            saveFile = argv[++i];
+        } else if (arg == "--save-world" && i + 1 < argc) {
+            worldFile = argv[++i];
+        } else if (arg == "--headless") {
+            // Aceptado por compatibilidad con 'Proyecto3 --headless'
+        } else {
+            std::cerr << "Unknown or incomplete option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!saveFile.empty() || !worldFile.empty()) {
+        SceneFile file;
+        if (sceneFile.empty()) {
+            std::cerr << "--save-scene and --save-world need --scene" << std::endl;
+            return 1;
+        }
+        if (!readSceneFile(sceneFile, file)) {
+            return 1;
+        }
+        if (!worldFile.empty()) {
+            if (!writeSceneWorld(worldFile, file)) {
+                return 1;
+            }
+            file.blocks.clear();
+        }
+        if (saveFile.empty()) {
+            return 0;
+        }
+        rebaseScenePaths(file, sceneFile, saveFile);
+        if (!worldFile.empty()) {
+            std::filesystem::path saveFolder = std::filesystem::absolute(saveFile).parent_path();
+            file.world = std::filesystem::relative(worldFile, saveFolder).generic_string();
+        }
+        return writeSceneBinary(saveFile, file) ? 0 : 1;
+    }
+
+    Scene scene(DECODER);
+    Camera camera = houseCamera();
+    if (sceneFile.empty()) {
+        setUp(scene);
+    } else if (!loadScene(sceneFile, scene, camera)) {
+        return 1;
+    }
+    scene.build();
+    ThreadPool pool(threadCount);
+
+    auto start = std::chrono::steady_clock::now();
+    ImageData image = renderStill(pool, scene, camera, width, height, samples);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Rendered " << width << "x" << height << " in " << ms << " ms with " << pool.size() << " threads" << std::endl;
+    return writeImage(outFile, image, PNG_ENCODER) ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include "house.h"
+#include "cube.h"
+
+void setUp(Scene& scene) {
+    scene.loadBackground(R"(..\assets\bc.png)");
+
+    MaterialId doorUp = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.18,
+            0.35,
+            5.0f,
+            0.0f,
+            0.0f,
+            2.0f,
+            scene.loadTexture(R"(..\assets\doorUp.png)")
+    });
+
+    MaterialId doorDown = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.18,
+            0.35,
+            5.0f,
+            0.0f,
+            0.0f,
+            2.0f,
+            scene.loadTexture(R"(..\assets\doorDown.png)")
+    });
+
+    MaterialId oak = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.18,
+            0.35,
+            3.0f,
+            0.0f,
+            0.0f,
+            3.0f,
+            scene.loadTexture(R"(..\assets\oak.png)")
+    });
+
+    MaterialId wood = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.16,
+            0.3,
+            2.0f,
+            0.0f,
+            0.0f,
+            3.0f,
+            scene.loadTexture(R"(..\assets\rawWood.png)")
+    });
+
+    MaterialId stone = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.3,
+            0.5,
+            3.0f,
+            0.0f,
+            0.0f,
+            1.6f,
+            scene.loadTexture(R"(..\assets\stone.png)")
+    });
+
+    MaterialId glowstone = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.8,
+            0.8,
+            20.0f,
+            0.1f,
+            0.05f,
+            1.7f,
+            scene.loadTexture(R"(..\assets\glowstone.png)")
+    });
+
+    MaterialId terracotta = scene.materials.add({
+            Color(80, 0, 0),   // diffuse
+            0.71,
+            0.67,
+            20.0f,
+            0.0f,
+            0.0f,
+            1.6f,
+            scene.loadTexture(R"(..\assets\terracotta.png)")
+    });
+
+    // Cara frontal
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 1.0f, -0.0f), 1.0f, doorUp));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 0.0f, -0.0f), 1.0f, doorDown));
+
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 0.0f, -0.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 1.0f, -0.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 0.0f, -0.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 1.0f, -0.0f), 1.0f, oak));
+
+    //scene.objects.push_back(new Cube(glm::vec3(1.0f, 2.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 2.0f, -0.0f), 1.0f, glowstone));
+    //scene.objects.push_back(new Cube(glm::vec3(-1.0f, 2.0f, -0.0f), 1.0f, stone));
+
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 0.0f, -0.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 1.0f, -0.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 2.0f, -0.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 0.0f, -0.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 1.0f, -0.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 2.0f, -0.0f), 1.0f, wood));
+
+    // cara derecha
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 0.0f, -1.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 0.0f, -2.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 0.0f, -3.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 1.0f, -1.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 1.0f, -2.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 1.0f, -3.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 2.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 2.0f, -2.0f), 1.0f, glowstone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 2.0f, -3.0f), 1.0f, stone));
+
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 0.0f, -4.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 1.0f, -4.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 2.0f, -4.0f), 1.0f, wood));
+
+    // cara izquierda
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 0.0f, -1.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 0.0f, -2.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 0.0f, -3.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 1.0f, -1.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 1.0f, -2.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 1.0f, -3.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 2.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 2.0f, -2.0f), 1.0f, glowstone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 2.0f, -3.0f), 1.0f, stone));
+
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 0.0f, -4.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 1.0f, -4.0f), 1.0f, wood));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 2.0f, -4.0f), 1.0f, wood));
+
+    // cara trasera
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 0.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 1.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 2.0f, -4.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 0.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 1.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 2.0f, -4.0f), 1.0f, glowstone));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 0.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 1.0f, -4.0f), 1.0f, oak));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 2.0f, -4.0f), 1.0f, stone));
+
+    // Techo
+    //scene.objects.push_back(new Cube(glm::vec3(-1.0f, 3.0f, -0.0f), 1.0f, terracotta));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 3.0f, -4.0f), 1.0f, terracotta));
+
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 4.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 4.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 4.0f, -2.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 4.0f, -3.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-1.0f, 4.0f, -4.0f), 1.0f, stone));
+
+    //scene.objects.push_back(new Cube(glm::vec3(1.0f, 3.0f, -0.0f), 1.0f, terracotta));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 3.0f, -4.0f), 1.0f, terracotta));
+
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 4.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 4.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 4.0f, -2.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 4.0f, -3.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(1.0f, 4.0f, -4.0f), 1.0f, stone));
+
+    //scene.objects.push_back(new Cube(glm::vec3(0.0f, 3.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 3.0f, -4.0f), 1.0f, stone));
+
+    //scene.objects.push_back(new Cube(glm::vec3(0.0f, 4.0f, -0.0f), 1.0f, terracotta));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 4.0f, -4.0f), 1.0f, terracotta));
+
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 5.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 5.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 5.0f, -2.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 5.0f, -3.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(0.0f, 5.0f, -4.0f), 1.0f, stone));
+
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 3.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 3.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 3.0f, -2.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 3.0f, -3.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(2.0f, 3.0f, -4.0f), 1.0f, stone));
+
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 3.0f, -0.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 3.0f, -1.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 3.0f, -2.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 3.0f, -3.0f), 1.0f, stone));
+    scene.objects.push_back(new Cube(glm::vec3(-2.0f, 3.0f, -4.0f), 1.0f, stone));
+
+}
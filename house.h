@@ -0,0 +1,12 @@
+#pragma once
+
+#include "scene.h"
+#include "camera.h"
+
+// Diorama de la casa: materiales, cubos y fondo
+void setUp(Scene& scene);
+
+// Camara inicial del diorama
+inline Camera houseCamera() {
+    return Camera(glm::vec3(0.0, 3.0, 10.0f), glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 10.0f);
+}
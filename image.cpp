@@ -0,0 +1,158 @@
+#include "image.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    std::string extensionOf(const std::string& file) {
+        size_t dot = file.find_last_of('.');
+        if (dot == std::string::npos) {
+            return "";
+        }
+        std::string ext = file.substr(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        return ext;
+    }
+
+    float srgbToLinear(uint8_t value) {
+        float c = value / 255.0f;
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    // EXR es little-endian
+    template <typename T>
+    void put(std::vector<char>& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(std::vector<char>& out, const char* text) {
+        out.insert(out.end(), text, text + std::strlen(text) + 1);
+    }
+
+    void putAttribute(std::vector<char>& out, const char* name, const char* type, int32_t size) {
+        putString(out, name);
+        putString(out, type);
+        put<int32_t>(out, size);
+    }
+}
+
+bool writeImage(const std::string& file, const ImageData& image, ImageEncoder pngEncoder) {
+    std::string ext = extensionOf(file);
+    if (ext == "ppm") {
+        return writePPM(file, image);
+    }
+    if (ext == "exr") {
+        return writeEXR(file, image);
+    }
+    if (ext == "png" && pngEncoder != nullptr) {
+        return pngEncoder(file, image);
+    }
+    std::cerr << "Unknown image format: " << file << std::endl;
+    return false;
+}
+
+bool writePPM(const std::string& file, const ImageData& image) {
+    const int width = image.width;
+    const int height = image.height;
+    const std::vector<uint8_t>& rgba = image.rgba;
+
+    std::ofstream out(file, std::ios::binary);
+    if (!out) {
+        std::cerr << "Unable to open " << file << std::endl;
+        return false;
+    }
+    out << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<char> row(static_cast<size_t>(width) * 3);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src = &rgba[static_cast<size_t>(y) * width * 4];
+        for (int x = 0; x < width; x++) {
+            row[x * 3 + 0] = static_cast<char>(src[x * 4 + 0]);
+            row[x * 3 + 1] = static_cast<char>(src[x * 4 + 1]);
+            row[x * 3 + 2] = static_cast<char>(src[x * 4 + 2]);
+        }
+        out.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+bool writeEXR(const std::string& file, const ImageData& image) {
+    const int width = image.width;
+    const int height = image.height;
+    const std::vector<uint8_t>& rgba = image.rgba;
+
+    std::vector<char> header;
+    put<int32_t>(header, 20000630);  // numero magico
+    put<int32_t>(header, 2);         // version 2, una parte por lineas
+
+    // Los canales van en orden alfabetico: B, G, R (2 = FLOAT)
+    putAttribute(header, "channels", "chlist", 3 * 18 + 1);
+    for (const char* channel : {"B", "G", "R"}) {
+        putString(header, channel);
+        put<int32_t>(header, 2);
+        put<int32_t>(header, 0);  // pLinear + reservado
+        put<int32_t>(header, 1);
+        put<int32_t>(header, 1);
+    }
+    header.push_back('\0');
+
+    putAttribute(header, "compression", "compression", 1);
+    header.push_back('\0');  // NO_COMPRESSION
+
+    for (const char* window : {"dataWindow", "displayWindow"}) {
+        putAttribute(header, window, "box2i", 16);
+        put<int32_t>(header, 0);
+        put<int32_t>(header, 0);
+        put<int32_t>(header, width - 1);
+        put<int32_t>(header, height - 1);
+    }
+
+    putAttribute(header, "lineOrder", "lineOrder", 1);
+    header.push_back('\0');  // INCREASING_Y
+
+    putAttribute(header, "pixelAspectRatio", "float", 4);
+    put<float>(header, 1.0f);
+
+    putAttribute(header, "screenWindowCenter", "v2f", 8);
+    put<float>(header, 0.0f);
+    put<float>(header, 0.0f);
+
+    putAttribute(header, "screenWindowWidth", "float", 4);
+    put<float>(header, 1.0f);
+    header.push_back('\0');
+
+    // Tabla de offsets: un bloque por linea
+    const int32_t lineBytes = width * 3 * static_cast<int32_t>(sizeof(float));
+    const uint64_t blockBytes = 8 + static_cast<uint64_t>(lineBytes);
+    uint64_t offset = header.size() + static_cast<uint64_t>(height) * 8;
+    for (int y = 0; y < height; y++) {
+        put<uint64_t>(header, offset + y * blockBytes);
+    }
+
+    std::ofstream out(file, std::ios::binary);
+    if (!out) {
+        std::cerr << "Unable to open " << file << std::endl;
+        return false;
+    }
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    std::vector<char> block;
+    block.reserve(blockBytes);
+    for (int y = 0; y < height; y++) {
+        block.clear();
+        put<int32_t>(block, y);
+        put<int32_t>(block, lineBytes);
+        const uint8_t* src = &rgba[static_cast<size_t>(y) * width * 4];
+        for (int channel : {2, 1, 0}) {
+            for (int x = 0; x < width; x++) {
+                put<float>(block, srgbToLinear(src[x * 4 + channel]));
+            }
+        }
+        out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Imagen RGBA8 en memoria, filas sin relleno
+struct ImageData {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// El nucleo no decodifica PNG por su cuenta; los frontends le pasan estas funciones
+using ImageDecoder = bool (*)(const std::string& file, ImageData& image);
+using ImageEncoder = bool (*)(const std::string& file, const ImageData& image);
+
+// Escribe la imagen segun la extension del archivo: .ppm, .exr o .png (este ultimo
+// solo si se pasa pngEncoder). Devuelve false si el formato no se reconoce o falla la escritura.
+bool writeImage(const std::string& file, const ImageData& image, ImageEncoder pngEncoder = nullptr);
+
+bool writePPM(const std::string& file, const ImageData& image);
+// OpenEXR de una parte, por lineas, sin compresion, canales R/G/B float en espacio lineal
+bool writeEXR(const std::string& file, const ImageData& image);
@@ -0,0 +1,73 @@
+#include "instance.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+Model::~Model() {
+    for (auto& object : objects) {
+        delete object;
+    }
+}
+
+void Model::build() {
+    std::vector<Object*> compiled;
+    compiled.reserve(objects.size());
+    for (auto& object : objects) {
+        if (dynamic_cast<const Instance*>(object) != nullptr) {
+            std::cerr << "Instances inside a model are not supported" << std::endl;
+            continue;
+        }
+        object->updateTransform();
+        compiled.push_back(object);
+    }
+    primitives.build(compiled);
+    bounds = primitives.bounds();
+}
+
+Instance::Instance(std::shared_ptr<const Model> model, const glm::vec3& position)
+        : Object(NO_MATERIAL), model(std::move(model)) {
+    translate(position);
+    updateTransform();
+}
+
+bool Instance::rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const {
+    glm::vec3 localOrigin, localDirection;
+    toLocal(rayOrigin, rayDirection, localOrigin, localDirection);
+    PrimitiveRef prim;
+    t = std::numeric_limits<float>::infinity();
+    return model->getPrimitives().intersect(localOrigin, localDirection, t, prim);
+}
+
+Intersect Instance::surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const {
+    // Sin estado entre la prueba y la superficie: se vuelve a buscar el primitivo mas cercano
+    glm::vec3 localOrigin, localDirection;
+    toLocal(rayOrigin, rayDirection, localOrigin, localDirection);
+    PrimitiveRef prim;
+    float tMax = std::nextafter(t, std::numeric_limits<float>::infinity());
+    if (!model->getPrimitives().intersect(localOrigin, localDirection, tMax, prim)) {
+        return Intersect{};
+    }
+    return toWorld(model->getPrimitives().surfaceAt(prim, localOrigin, localDirection, tMax), rayOrigin, rayDirection);
+}
+
+AABB Instance::getBounds() const {
+    const AABB& local = model->getBounds();
+    AABB world;
+    if (local.min.x > local.max.x) {
+        return world;
+    }
+    const glm::mat4& transform = getTransformMatrix();
+    for (int corner = 0; corner < 8; corner++) {
+        glm::vec3 p((corner & 1) ? local.max.x : local.min.x, (corner & 2) ? local.max.y : local.min.y,
+                    (corner & 4) ? local.max.z : local.min.z);
+        world.expand(glm::vec3(transform * glm::vec4(p, 1.0f)));
+    }
+    return world;
+}
+
+Intersect Instance::toWorld(const Intersect& local, const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const {
+    Intersect world = local;
+    world.point = rayOrigin + local.dist * rayDirection;
+    world.normal = glm::normalize(getNormalMatrix() * local.normal);
+    return world;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "glm/glm.hpp"
+#include "object.h"
+#include "primitiveset.h"
+
+// Geometria compartida por varias instancias (BLAS): sus objetos se compilan una sola vez en un
+// BVH propio, en su propio espacio. Los materiales son ids de la escena que la usa.
+class Model {
+public:
+    Model() = default;
+    ~Model();
+
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+
+    // Compila 'objects'; despues se puede compartir entre instancias pero no modificar
+    void build();
+
+    const PrimitiveSet& getPrimitives() const { return primitives; }
+    const AABB& getBounds() const { return bounds; }
+
+    std::vector<Object*> objects;  // cubos, esferas u otros objetos; sin instancias
+
+private:
+    PrimitiveSet primitives;
+    AABB bounds;
+};
+
+// Copia de un modelo con su propia transformacion (position, rotate, scaleObject). El BVH de la
+// escena guarda las instancias (TLAS) y el rayo pasa al espacio del modelo con la inversa
+// cacheada, sin normalizar la direccion para que t siga siendo la del rayo original.
+class Instance : public Object {
+public:
+    Instance(std::shared_ptr<const Model> model, const glm::vec3& position);
+
+    bool rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const override;
+    Intersect surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const override;
+
+    // Caja del modelo transformada; usa las matrices de la ultima updateTransform()
+    AABB getBounds() const override;
+
+    const Model& getModel() const { return *model; }
+
+    // Rayo en espacio del modelo
+    void toLocal(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, glm::vec3& localOrigin, glm::vec3& localDirection) const {
+        const glm::mat4& inverse = getInverseMatrix();
+        localOrigin = glm::vec3(inverse * glm::vec4(rayOrigin, 1.0f));
+        localDirection = glm::mat3(inverse) * rayDirection;
+    }
+
+    // Superficie de vuelta a espacio mundo para el rayo original
+    Intersect toWorld(const Intersect& local, const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const;
+
+private:
+    std::shared_ptr<const Model> model;
+};
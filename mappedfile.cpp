@@ -0,0 +1,124 @@
+#include "mappedfile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& file) {
+    close();
+    HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Cannot open " << file << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        std::cerr << "Cannot read the size of " << file << std::endl;
+        CloseHandle(handle);
+        return false;
+    }
+    fileHandle = handle;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr) {
+        std::cerr << "Cannot map " << file << std::endl;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+    bytes = static_cast<const uint8_t*>(view);
+    return true;
+}
+
+void MappedFile::prefetch(size_t offset, size_t count) const {
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<uint8_t*>(bytes + offset), count};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void MappedFile::release(size_t offset, size_t count) const {
+    // Desbloquear paginas que no estan bloqueadas las saca del working set
+    VirtualUnlock(const_cast<uint8_t*>(bytes + offset), count);
+}
+
+void MappedFile::close() {
+    if (bytes != nullptr) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+#else
+bool MappedFile::open(const std::string& file) {
+    close();
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << file << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        std::cerr << "Cannot read the size of " << file << std::endl;
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    // El mapeo sigue valido despues de cerrar el descriptor
+    void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "Cannot map " << file << std::endl;
+        length = 0;
+        return false;
+    }
+    bytes = static_cast<const uint8_t*>(view);
+    return true;
+}
+
+void MappedFile::prefetch(size_t offset, size_t count) const {
+    madvise(const_cast<uint8_t*>(bytes + offset), count, MADV_WILLNEED);
+}
+
+void MappedFile::release(size_t offset, size_t count) const {
+    // El mapeo es privado y nunca se escribe: las paginas soltadas se vuelven a leer del archivo
+    madvise(const_cast<uint8_t*>(bytes + offset), count, MADV_DONTNEED);
+}
+
+void MappedFile::close() {
+    if (bytes != nullptr) {
+        munmap(const_cast<uint8_t*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+}
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Archivo de solo lectura proyectado en memoria (mmap, o MapViewOfFile en Windows).
+// Las paginas se leen del disco cuando se tocan; data() vale hasta close() o el destructor.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Devuelve false e imprime el motivo si no se puede abrir o proyectar
+    bool open(const std::string& file);
+    void close();
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Avisa al sistema que [offset, offset + count) se va a leer pronto, o que puede soltar esas
+    // paginas; si se vuelven a tocar se leen otra vez del archivo. Son solo sugerencias.
+    void prefetch(size_t offset, size_t count) const;
+    void release(size_t offset, size_t count) const;
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
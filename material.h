@@ -1,6 +1,9 @@
 #pragma once
 
 #include "color.h"
+#include "texture.h"
+#include <cstdint>
+#include <vector>
 
 struct Material {
   Color diffuse;
@@ -10,5 +13,42 @@ struct Material {
   float reflectivity;
   float transparency;
   float refractionIndex;
-  SDL_Surface* surface;
+  const Texture* texture;
+};
+
+// Mismos valores campo por campo; sirve para no repetir materiales iguales
+inline bool sameMaterial(const Material& a, const Material& b) {
+  return a.diffuse.r == b.diffuse.r && a.diffuse.g == b.diffuse.g && a.diffuse.b == b.diffuse.b && a.diffuse.a == b.diffuse.a &&
+         a.albedo == b.albedo && a.specularAlbedo == b.specularAlbedo && a.specularCoefficient == b.specularCoefficient &&
+         a.reflectivity == b.reflectivity && a.transparency == b.transparency && a.refractionIndex == b.refractionIndex &&
+         a.texture == b.texture;
+}
+
+// Id de 16 bits de un material en una MaterialTable. 0 no es un material valido:
+// VoxelGrid lo usa para las celdas vacias.
+using MaterialId = uint16_t;
+const MaterialId NO_MATERIAL = 0;
+
+// Tabla unica de materiales de una escena. Los objetos y las celdas de la malla guardan
+// solo el id, asi que editar una entrada cambia todo lo que la usa.
+class MaterialTable {
+public:
+  // Devuelve el id de un material igual al dado, agregandolo si hace falta
+  MaterialId add(const Material& material) {
+    for (size_t i = 0; i < materials.size(); ++i) {
+      if (sameMaterial(materials[i], material)) {
+        return static_cast<MaterialId>(i + 1);
+      }
+    }
+    materials.push_back(material);
+    return static_cast<MaterialId>(materials.size());
+  }
+
+  const Material& operator[](MaterialId id) const { return materials[id - 1]; }
+  Material& operator[](MaterialId id) { return materials[id - 1]; }
+
+  size_t size() const { return materials.size(); }
+
+private:
+  std::vector<Material> materials;
 };
@@ -4,44 +4,86 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "material.h"
 #include "intersect.h"
-#include <SDL.h>
+#include "aabb.h"
 
 class Object {
 public:
-    Object(const Material& mat) : material(mat), position(glm::vec3(0.0f)), rotationAxis(glm::vec3(0.0f, 1.0f, 0.0f)), rotationAngle(0.0f), scale(glm::vec3(1.0f)), texture(nullptr) {}
+    Object(MaterialId mat) : material(mat), position(glm::vec3(0.0f)), rotationAxis(glm::vec3(0.0f, 1.0f, 0.0f)), rotationAngle(0.0f), scale(glm::vec3(1.0f)) {
+        updateTransform();
+    }
+
+    virtual ~Object() = default;
+
+    // Prueba candidata: solo la distancia t >= 0 del corte, sin punto, normal ni uv
+    virtual bool rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const = 0;
+
+    // Punto, normal y uv del corte a distancia t; se calcula una sola vez, para el corte mas cercano
+    virtual Intersect surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const = 0;
+
+    Intersect rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const {
+        float t;
+        if (!rayDistance(rayOrigin, rayDirection, t)) {
+            return Intersect{};
+        }
+        return surfaceAt(rayOrigin, rayDirection, t);
+    }
+
+    // Prueba de oclusion para rayos de sombra: si hay un corte con 0 < t < tMax.
+    // 't' recibe la distancia del corte.
+    bool occludes(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax, float& t) const {
+        return rayDistance(rayOrigin, rayDirection, t) && t > 0 && t < tMax;
+    }
 
-    virtual Intersect rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const = 0;
+    // Caja envolvente en espacio mundo, usada para construir el BVH
+    virtual AABB getBounds() const = 0;
 
-    // Funciones para transformaciones
-    void translate(const glm::vec3& translation) { position += translation; }
+    // Funciones para transformaciones; marcan las matrices cacheadas como desactualizadas.
+    // Solo Instance mueve su geometria con ellas: Cube y Sphere quedan en su centro.
+    void translate(const glm::vec3& translation) {
+        position += translation;
+        transformDirty = true;
+    }
     void rotate(float angle, const glm::vec3& axis) {
         rotationAngle += angle;
         rotationAxis = glm::normalize(rotationAxis + axis);
+        transformDirty = true;
     }
-    void scaleObject(const glm::vec3& scaleFactor) { scale *= scaleFactor; }
+    void scaleObject(const glm::vec3& scaleFactor) {
+        scale *= scaleFactor;
+        transformDirty = true;
+    }
+
+    bool isTransformDirty() const { return transformDirty; }
 
-    // Función para obtener la matriz de transformación del objeto
-    glm::mat4 getTransformMatrix() const {
+    // Recalcula la matriz de mundo, su inversa y la matriz de normales si hubo cambios.
+    // Se llama desde el hilo principal antes de trazar; los getters solo leen.
+    void updateTransform() {
+        if (!transformDirty) {
+            return;
+        }
         glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), position);
         glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), rotationAngle, rotationAxis);
         glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), scale);
-        return translationMatrix * rotationMatrix * scaleMatrix;
+        worldMatrix = translationMatrix * rotationMatrix * scaleMatrix;
+        inverseMatrix = glm::inverse(worldMatrix);
+        normalMatrix = glm::mat3(glm::transpose(inverseMatrix));
+        transformDirty = false;
     }
 
-    void setTexture(SDL_Texture* tex) {
-        texture = tex;
-    }
-
-    SDL_Texture* getTexture() const {
-        return texture;
-    }
+    // Matrices cacheadas de la ultima llamada a updateTransform()
+    const glm::mat4& getTransformMatrix() const { return worldMatrix; }
+    const glm::mat4& getInverseMatrix() const { return inverseMatrix; }
+    const glm::mat3& getNormalMatrix() const { return normalMatrix; }
 
     glm::vec3 position;
     glm::vec3 rotationAxis;
     float rotationAngle;
     glm::vec3 scale;
-    Material material;
+    MaterialId material;  // id en la MaterialTable de la escena
 
 private:
-    SDL_Texture* texture;
+    bool transformDirty = true;
+    glm::mat4 worldMatrix = glm::mat4(1.0f);
+    glm::mat4 inverseMatrix = glm::mat4(1.0f);
+    glm::mat3 normalMatrix = glm::mat3(1.0f);
 };
@@ -0,0 +1,234 @@
+#include "primitiveset.h"
+#include "cube.h"
+#include "instance.h"
+#include "sphere.h"
+
+void PrimitiveSet::build(const std::vector<Object*>& objects) {
+    std::vector<AABB> bounds;
+    bounds.reserve(objects.size());
+    for (const Object* object : objects) {
+        bounds.push_back(object->getBounds());
+    }
+    build(objects, std::move(bounds));
+}
+
+void PrimitiveSet::build(const std::vector<Object*>& objects, std::vector<AABB> bounds) {
+    cubes = CubeArray();
+    spheres = SphereArray();
+    others = ObjectArray();
+    instances = InstanceArray();
+    leafOffsets.clear();
+    primBounds = std::move(bounds);
+
+    // Hojas de hasta BoxSet::WIDTH para que los cubos de una hoja se prueben juntos
+    bvh.build(primBounds, BoxSet::WIDTH);
+    builtCost = bvh.sahCost();
+
+    // Reparte los objetos por tipo siguiendo el orden de las hojas
+    PrimitiveOffsets offsets;
+    leafOffsets.reserve(objects.size() + 1);
+    for (uint32_t owner : bvh.leafOrder()) {
+        leafOffsets.push_back(offsets);
+        const Object* object = objects[owner];
+        MaterialId material = object->material;
+
+        if (const auto* cube = dynamic_cast<const Cube*>(object)) {
+            // Cube::rayDistance no usa la transformacion: su caja es exacta
+            cubes.boxes.add(primBounds[owner]);
+            cubes.centers.push_back(cube->getCenter());
+            cubes.sizes.push_back(cube->getSize());
+            cubes.materials.push_back(material);
+            offsets.cube++;
+        } else if (const auto* sphere = dynamic_cast<const Sphere*>(object)) {
+            spheres.spheres.emplace_back(sphere->getCenter(), sphere->getRadius());
+            spheres.materials.push_back(material);
+            offsets.sphere++;
+        } else if (const auto* instance = dynamic_cast<const Instance*>(object)) {
+            instances.instances.push_back(instance);
+            offsets.instance++;
+        } else {
+            others.objects.push_back(object);
+            others.materials.push_back(material);
+            offsets.other++;
+        }
+    }
+    leafOffsets.push_back(offsets);
+}
+
+void PrimitiveSet::refit(const std::vector<Object*>& objects, const std::vector<uint32_t>& moved) {
+    for (uint32_t index : moved) {
+        primBounds[index] = objects[index]->getBounds();
+    }
+    bvh.refit(primBounds, moved);
+}
+
+AABB PrimitiveSet::bounds() const {
+    if (bvh.empty()) {
+        return AABB();
+    }
+    return bvh.rootBounds();
+}
+
+void PrimitiveSet::testLeaf(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const glm::vec3& invDir,
+                            uint32_t first, uint32_t count, float& tMax, PrimitiveRef& prim) const {
+    const PrimitiveOffsets& begin = leafOffsets[first];
+    const PrimitiveOffsets& end = leafOffsets[first + count];
+
+    // Cubos de a BoxSet::WIDTH
+    if (end.cube > begin.cube) {
+        int box = cubes.boxes.nearest(rayOrigin, invDir, begin.cube, end.cube - begin.cube, 0.0f, tMax);
+        if (box >= 0) {
+            prim = {PrimitiveKind::Cube, static_cast<uint32_t>(box)};
+        }
+    }
+
+    for (uint32_t i = begin.sphere; i < end.sphere; ++i) {
+        const glm::vec4& sphere = spheres.spheres[i];
+        float t;
+        if (Sphere::distance(glm::vec3(sphere), sphere.w, rayOrigin, rayDirection, t) && t < tMax) {
+            tMax = t;
+            prim = {PrimitiveKind::Sphere, i};
+        }
+    }
+
+    // Unico caso con llamadas virtuales: subclases de Object que no tienen arreglo propio
+    for (uint32_t i = begin.other; i < end.other; ++i) {
+        float t;
+        if (others.objects[i]->rayDistance(rayOrigin, rayDirection, t) && t < tMax) {
+            tMax = t;
+            prim = {PrimitiveKind::Other, i};
+        }
+    }
+
+    // Cada instancia recorre el BVH de su modelo con el rayo en espacio del modelo; t no cambia
+    for (uint32_t i = begin.instance; i < end.instance; ++i) {
+        glm::vec3 localOrigin, localDirection;
+        instances.instances[i]->toLocal(rayOrigin, rayDirection, localOrigin, localDirection);
+        PrimitiveRef local;
+        if (instances.instances[i]->getModel().getPrimitives().intersect(localOrigin, localDirection, tMax, local)) {
+            prim = local;
+            prim.instance = i;
+        }
+    }
+}
+
+bool PrimitiveSet::intersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& tMax, PrimitiveRef& prim) const {
+    glm::vec3 invDir = 1.0f / rayDirection;
+    PrimitiveKind found = PrimitiveKind::None;
+    bvh.traverseLeaves(rayOrigin, rayDirection, tMax, [&](uint32_t first, uint32_t count, float& limit) {
+        PrimitiveRef leafPrim;
+        testLeaf(rayOrigin, rayDirection, invDir, first, count, limit, leafPrim);
+        if (leafPrim.kind != PrimitiveKind::None) {
+            prim = leafPrim;
+            found = leafPrim.kind;
+        }
+    });
+    return found != PrimitiveKind::None;
+}
+
+bool PrimitiveSet::occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax,
+                            const PrimitiveRef& skip, float& t) const {
+    const float tMin = std::numeric_limits<float>::min();
+    glm::vec3 invDir = 1.0f / rayDirection;
+    bool local = skip.instance == PrimitiveRef::NO_INSTANCE;
+    uint32_t skipCube = local && skip.kind == PrimitiveKind::Cube ? skip.index : BoxSet::NO_SKIP;
+    // Cada bloqueador acorta 'limit', asi que al final queda el mas cercano sin importar la forma
+    // del arbol
+    bool blocked = false;
+    bvh.traverseLeaves(rayOrigin, rayDirection, tMax, [&](uint32_t first, uint32_t count, float& limit) {
+        const PrimitiveOffsets& begin = leafOffsets[first];
+        const PrimitiveOffsets& end = leafOffsets[first + count];
+
+        if (end.cube > begin.cube && cubes.boxes.nearest(rayOrigin, invDir, begin.cube, end.cube - begin.cube, tMin, limit, skipCube) >= 0) {
+            blocked = true;
+        }
+        float blocker;
+        for (uint32_t i = begin.sphere; i < end.sphere; ++i) {
+            if (local && skip.kind == PrimitiveKind::Sphere && skip.index == i) {
+                continue;
+            }
+            const glm::vec4& sphere = spheres.spheres[i];
+            if (Sphere::distance(glm::vec3(sphere), sphere.w, rayOrigin, rayDirection, blocker) && blocker > 0 && blocker < limit) {
+                limit = blocker;
+                blocked = true;
+            }
+        }
+        for (uint32_t i = begin.other; i < end.other; ++i) {
+            if (!(local && skip.kind == PrimitiveKind::Other && skip.index == i) && others.objects[i]->occludes(rayOrigin, rayDirection, limit, blocker)) {
+                limit = blocker;
+                blocked = true;
+            }
+        }
+        // Dentro de la instancia de donde sale el rayo solo se ignora su primitivo
+        for (uint32_t i = begin.instance; i < end.instance; ++i) {
+            PrimitiveRef localSkip;
+            if (skip.instance == i) {
+                localSkip = skip;
+                localSkip.instance = PrimitiveRef::NO_INSTANCE;
+            }
+            glm::vec3 localOrigin, localDirection;
+            instances.instances[i]->toLocal(rayOrigin, rayDirection, localOrigin, localDirection);
+            if (instances.instances[i]->getModel().getPrimitives().occluded(localOrigin, localDirection, limit, localSkip, blocker)) {
+                limit = blocker;
+                blocked = true;
+            }
+        }
+    });
+    if (blocked) {
+        t = tMax;
+    }
+    return blocked;
+}
+
+Intersect PrimitiveSet::surfaceAt(const PrimitiveRef& prim, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const {
+    if (prim.instance != PrimitiveRef::NO_INSTANCE) {
+        const Instance* instance = instances.instances[prim.instance];
+        PrimitiveRef local = prim;
+        local.instance = PrimitiveRef::NO_INSTANCE;
+        glm::vec3 localOrigin, localDirection;
+        instance->toLocal(rayOrigin, rayDirection, localOrigin, localDirection);
+        Intersect surface = instance->getModel().getPrimitives().surfaceAt(local, localOrigin, localDirection, t);
+        return instance->toWorld(surface, rayOrigin, rayDirection);
+    }
+
+    switch (prim.kind) {
+        case PrimitiveKind::Cube:
+            return Cube::surface(cubes.centers[prim.index], cubes.sizes[prim.index], rayOrigin, rayDirection, t);
+        case PrimitiveKind::Sphere:
+            return Sphere::surface(glm::vec3(spheres.spheres[prim.index]), rayOrigin, rayDirection, t);
+        case PrimitiveKind::Other:
+            return others.objects[prim.index]->surfaceAt(rayOrigin, rayDirection, t);
+        default:
+            return Intersect{};
+    }
+}
+
+MaterialId PrimitiveSet::materialIdOf(const PrimitiveRef& prim) const {
+    if (prim.instance != PrimitiveRef::NO_INSTANCE) {
+        PrimitiveRef local = prim;
+        local.instance = PrimitiveRef::NO_INSTANCE;
+        return instances.instances[prim.instance]->getModel().getPrimitives().materialIdOf(local);
+    }
+
+    switch (prim.kind) {
+        case PrimitiveKind::Cube:
+            return cubes.materials[prim.index];
+        case PrimitiveKind::Sphere:
+            return spheres.materials[prim.index];
+        case PrimitiveKind::Other:
+            return others.materials[prim.index];
+        default:
+            return NO_MATERIAL;
+    }
+}
+
+glm::mat3 PrimitiveSet::normalMatrixOf(const PrimitiveRef& prim) const {
+    if (prim.instance != PrimitiveRef::NO_INSTANCE) {
+        return glm::mat3(1.0f);
+    }
+
+    if (prim.kind == PrimitiveKind::Other) {
+        return others.objects[prim.index]->getNormalMatrix();
+    }
+    return glm::mat3(1.0f);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "aabb.h"
+#include "boxset.h"
+#include "bvh.h"
+#include "intersect.h"
+#include "material.h"
+#include "object.h"
+
+class Instance;
+
+enum class PrimitiveKind : uint8_t { None, Voxel, Block, Cube, Sphere, Other };
+
+// Primitivo compilado: su tipo y su posicion en el arreglo de ese tipo, o la celda si es un voxel
+// de un mundo en disco. Si 'instance' no es NO_INSTANCE, tipo e indice son del modelo de esa
+// instancia del arreglo de instancias.
+struct PrimitiveRef {
+    static const uint32_t NO_INSTANCE = 0xFFFFFFFF;
+
+    PrimitiveKind kind = PrimitiveKind::None;
+    uint32_t index = 0;
+    glm::ivec3 cell = glm::ivec3(0);
+    uint32_t instance = NO_INSTANCE;
+};
+
+// Cubos compilados en el orden de las hojas del BVH: cajas SoA para probar 8 a la vez,
+// centro y tamaño para la superficie
+struct CubeArray {
+    BoxSet boxes;
+    std::vector<glm::vec3> centers;
+    std::vector<float> sizes;
+    std::vector<MaterialId> materials;  // id en Scene::materials
+};
+
+// Esferas compiladas en el orden de las hojas del BVH: centro en xyz y radio en w
+struct SphereArray {
+    std::vector<glm::vec4> spheres;
+    std::vector<MaterialId> materials;
+};
+
+// Cualquier otra subclase de Object: se prueba con llamadas virtuales
+struct ObjectArray {
+    std::vector<const Object*> objects;
+    std::vector<MaterialId> materials;
+};
+
+// Instancias de modelos compartidos; cada una lleva el rayo al espacio de su modelo
+struct InstanceArray {
+    std::vector<const Instance*> instances;
+};
+
+// Cuantos primitivos de cada tipo hay antes de una posicion del orden de hojas del BVH
+struct PrimitiveOffsets {
+    uint32_t cube = 0;
+    uint32_t sphere = 0;
+    uint32_t other = 0;
+    uint32_t instance = 0;
+};
+
+// Objetos compilados en un BVH y arreglos contiguos por tipo. La escena tiene uno con sus
+// objetos e instancias (el nivel de arriba) y cada Model uno con su geometria (el de abajo).
+// Los arreglos siguen el orden de las hojas: los cubos de la hoja [first, first + count) son
+// [leafOffsets[first].cube, leafOffsets[first + count].cube) de 'cubes', y lo mismo para los
+// otros tipos.
+class PrimitiveSet {
+public:
+    // Los objetos siguen siendo de quien llama; el primitivo i es objects[i]
+    void build(const std::vector<Object*>& objects);
+    // Igual, con la caja de cada objeto ya calculada. No lee las transformaciones, asi que puede
+    // correr en otro hilo mientras los objetos se mueven.
+    void build(const std::vector<Object*>& objects, std::vector<AABB> bounds);
+
+    // Ajusta en el BVH las cajas de los objetos 'moved' (indices de 'objects'), sin reconstruirlo
+    void refit(const std::vector<Object*>& objects, const std::vector<uint32_t>& moved);
+    // Costo SAH actual sobre el de recien construido: cuanto empeoraron los refit el arbol
+    float costGrowth() const { return builtCost > 0.0f ? bvh.sahCost() / builtCost : 1.0f; }
+    const std::vector<AABB>& getBounds() const { return primBounds; }
+
+    bool empty() const { return bvh.empty(); }
+    AABB bounds() const;
+
+    // Pruebas candidatas de una hoja [first, first + count): un ciclo por tipo. Reduce tMax y
+    // anota el primitivo mas cercano en 'prim'.
+    void testLeaf(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const glm::vec3& invDir,
+                  uint32_t first, uint32_t count, float& tMax, PrimitiveRef& prim) const;
+
+    // Corte mas cercano con t < tMax recorriendo el BVH; solo la distancia
+    bool intersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& tMax, PrimitiveRef& prim) const;
+
+    // Bloqueador mas cercano con 0 < t < tMax, sin contar 'skip'. 't' recibe su distancia.
+    bool occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax,
+                  const PrimitiveRef& skip, float& t) const;
+
+    // Normal y uv del corte a distancia t con un primitivo de este conjunto, en espacio mundo
+    Intersect surfaceAt(const PrimitiveRef& prim, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const;
+
+    MaterialId materialIdOf(const PrimitiveRef& prim) const;
+    // Las instancias devuelven la superficie ya en espacio mundo, y cubos y esferas no usan su
+    // transformacion: para ellos la matriz es la identidad
+    glm::mat3 normalMatrixOf(const PrimitiveRef& prim) const;
+
+    BVH bvh;
+    std::vector<PrimitiveOffsets> leafOffsets;
+    CubeArray cubes;
+    SphereArray spheres;
+    ObjectArray others;
+    InstanceArray instances;
+
+private:
+    std::vector<AABB> primBounds;  // caja de cada objeto, por indice de 'objects'
+    float builtCost = 0.0f;
+};
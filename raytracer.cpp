@@ -0,0 +1,365 @@
+#include "raytracer.h"
+#include "reprojection.h"
+#include <bit>
+#include <cmath>
+
+namespace {
+    // Cajas de bloques de una hoja [first, first + count) de Scene::blockBvh
+    void testBlocks(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& invDir,
+                    uint32_t first, uint32_t count, float& tMax, PrimitiveRef& prim) {
+        int box = scene.blocks.boxes.nearest(rayOrigin, invDir, first, count, 0.0f, tMax);
+        if (box >= 0) {
+            prim = {PrimitiveKind::Block, static_cast<uint32_t>(box)};
+        }
+    }
+
+    // Normal y uv solo para el corte final, a distancia t
+    Intersect surfaceOf(const Scene& scene, const PrimitiveRef& prim, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) {
+        switch (prim.kind) {
+            case PrimitiveKind::Block:
+                return VoxelGrid::blockSurface(scene.blocks.cells[prim.index], rayOrigin, rayDirection, t);
+            case PrimitiveKind::Voxel:
+                return scene.grid.surfaceAt(rayOrigin, rayDirection, VoxelHit{t, prim.cell});
+            case PrimitiveKind::None:
+                return Intersect{};
+            default:
+                return scene.primitives.surfaceAt(prim, rayOrigin, rayDirection, t);
+        }
+    }
+
+    // Posicion dentro del pixel de la muestra 'sample': el centro para la primera y despues la
+    // secuencia de Halton en bases 2 y 3, que cubre el pixel de forma pareja sin estado entre hilos
+    float radicalInverse(int index, int base) {
+        float inverse = 1.0f / static_cast<float>(base);
+        float fraction = inverse;
+        float result = 0.0f;
+        for (; index > 0; index /= base) {
+            result += static_cast<float>(index % base) * fraction;
+            fraction *= inverse;
+        }
+        return result;
+    }
+
+    glm::vec2 samplePosition(int sample) {
+        if (sample == 0) {
+            return glm::vec2(0.5f);
+        }
+        return glm::vec2(radicalInverse(sample, 2), radicalInverse(sample, 3));
+    }
+
+    // Anota en la cache la superficie de un pixel trazado por el centro. Solo se puede volver a
+    // iluminar sin rayos si el color no depende de rayos secundarios ni de una transformacion.
+    void recordSurface(const Scene& scene, ReprojectionCache& surfaces, int x, int y, const SceneHit* hit,
+                       const ViewIndependentShading& terms) {
+        if (hit == nullptr) {
+            surfaces.record(x, y, nullptr, terms, NO_MATERIAL, false);
+            return;
+        }
+        MaterialId materialId = scene.materialIdOf(hit->prim);
+        const Material& material = scene.materials[materialId];
+        bool viewDependent = material.reflectivity > 0 || material.transparency > 0 || scene.normalMatrixOf(hit->prim) != glm::mat3(1.0f);
+        surfaces.record(x, y, &hit->intersect, terms, materialId, viewDependent);
+    }
+
+    // Reparte la imagen de width x height en tiles de TILE_SIZE x TILE_SIZE entre los hilos del pool y
+    // traza cada tile en paquetes de hasta PACKET_SIZE x PACKET_SIZE rayos primarios. 'offset' es el
+    // punto dentro de cada pixel por donde pasa el rayo; 'write(x, y, color, hit, terms)' recibe el
+    // resultado, con hit == nullptr si no hay corte. Con 'mask' solo se trazan los pixeles distintos de 0.
+    // Con 'cancel' cancelado no se empiezan paquetes nuevos.
+    template <typename Write>
+    void submitTiles(ThreadPool& pool, const Scene& scene, const Camera& camera, int width, int height,
+                     glm::vec2 offset, const uint8_t* mask, CancelToken cancel, Write write) {
+        const Scene* tracedScene = &scene;
+        const float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+
+        glm::vec3 cameraPosition = camera.position;
+        glm::vec3 cameraDir = glm::normalize(camera.target - camera.position);
+        glm::vec3 cameraX = glm::normalize(glm::cross(cameraDir, camera.up));
+        glm::vec3 cameraY = glm::normalize(glm::cross(cameraX, cameraDir));
+        float tanHalfFov = tan(FOV / 2.0f);
+
+        const int tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+        const int tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+        pool.submit(tilesX * tilesY, [=](size_t tile) {
+            int startX = static_cast<int>(tile % tilesX) * TILE_SIZE;
+            int startY = static_cast<int>(tile / tilesX) * TILE_SIZE;
+            int endX = std::min(startX + TILE_SIZE, width);
+            int endY = std::min(startY + TILE_SIZE, height);
+
+            glm::vec3 directions[PACKET_SIZE * PACKET_SIZE];
+            SceneHit hits[PACKET_SIZE * PACKET_SIZE];
+            glm::ivec2 pixels[PACKET_SIZE * PACKET_SIZE];
+            for (int packetY = startY; packetY < endY; packetY += PACKET_SIZE) {
+                for (int packetX = startX; packetX < endX; packetX += PACKET_SIZE) {
+                    if (cancel.cancelled()) {
+                        return;
+                    }
+                    int packetEndX = std::min(packetX + PACKET_SIZE, endX);
+                    int packetEndY = std::min(packetY + PACKET_SIZE, endY);
+
+                    int count = 0;
+                    for (int y = packetY; y < packetEndY; y++) {
+                        for (int x = packetX; x < packetEndX; x++) {
+                            if (mask != nullptr && mask[static_cast<size_t>(y) * width + x] == 0) {
+                                continue;
+                            }
+                            float screenX = (2.0f * (x + offset.x)) / width - 1.0f;
+                            float screenY = -(2.0f * (y + offset.y)) / height + 1.0f;
+                            screenX *= aspectRatio;
+                            screenX *= tanHalfFov;
+                            screenY *= tanHalfFov;
+
+                            pixels[count] = glm::ivec2(x, y);
+                            directions[count++] = glm::normalize(
+                                    cameraDir + cameraX * screenX + cameraY * screenY
+                            );
+                        }
+                    }
+                    if (count == 0) {
+                        continue;
+                    }
+
+                    closestHitPacket(*tracedScene, cameraPosition, directions, count, hits);
+
+                    for (int lane = 0; lane < count; lane++) {
+                        const glm::ivec2& pixel = pixels[lane];
+                        if (hits[lane].intersect.isIntersecting && MAX_RECURSION > 0) {
+                            ViewIndependentShading terms;
+                            Color color = shade(*tracedScene, cameraPosition, directions[lane], hits[lane], 0, &terms);
+                            write(pixel.x, pixel.y, color, &hits[lane], terms);
+                        } else {
+                            write(pixel.x, pixel.y, Color(), nullptr, ViewIndependentShading());
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+float castShadow(const Scene& scene, const glm::vec3& shadowOrigin, const glm::vec3& lightDir, const PrimitiveRef& hitPrim) {
+    // Solo cuentan los bloqueadores entre el punto y la luz; basta con el primero que aparezca
+    float lightDistance = glm::length(scene.light.position - shadowOrigin);
+    float blocker;
+    if (scene.occluded(shadowOrigin, lightDir, lightDistance, hitPrim, blocker)) {
+        float shadowRatio = glm::min(1.0f, blocker / lightDistance);
+        return 1.0f - shadowRatio;
+    }
+    return 1.0f;
+}
+
+bool closestHit(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, SceneHit& hit) {
+    float zBuffer = 99999;
+    hit = SceneHit();
+
+    // Primero los bloques, compilados en cajas o por DDA si son de un mundo en disco; su
+    // distancia acota el recorrido del BVH. Las pruebas candidatas solo dan distancias; la
+    // superficie se calcula al final.
+    glm::vec3 invDir = 1.0f / rayDirection;
+    VoxelHit voxelHit;
+    if (scene.grid.isStreaming()) {
+        if (scene.grid.intersect(rayOrigin, rayDirection, 0.0f, zBuffer, voxelHit)) {
+            zBuffer = voxelHit.t;
+            hit.prim = {PrimitiveKind::Voxel, 0, voxelHit.cell};
+        }
+    } else {
+        scene.blockBvh.traverseLeaves(rayOrigin, rayDirection, zBuffer, [&](uint32_t first, uint32_t count, float& tMax) {
+            testBlocks(scene, rayOrigin, invDir, first, count, tMax, hit.prim);
+        });
+    }
+
+    scene.primitives.bvh.traverseLeaves(rayOrigin, rayDirection, zBuffer, [&](uint32_t first, uint32_t count, float& tMax) {
+        scene.primitives.testLeaf(rayOrigin, rayDirection, invDir, first, count, tMax, hit.prim);
+    });
+
+    hit.intersect = surfaceOf(scene, hit.prim, rayOrigin, rayDirection, zBuffer);
+    return hit.intersect.isIntersecting;
+}
+
+Color directLight(const Scene& scene, const Material& material, const ViewIndependentShading& terms, const glm::vec3& viewDirObjSpace) {
+    float specLightIntensity = std::pow(glm::max(0.0f, glm::dot(viewDirObjSpace, terms.reflectDir)), material.specularCoefficient);
+    Color specularLight = scene.light.color * scene.light.intensity * specLightIntensity * material.specularAlbedo * terms.shadow;
+    return terms.diffuse + specularLight;
+}
+
+Color shade(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const SceneHit& hit, const short recursion,
+            ViewIndependentShading* terms) {
+    const Intersect& intersect = hit.intersect;
+    const Material& material = scene.materialOf(hit.prim);
+    glm::mat3 normalMatrix = scene.normalMatrixOf(hit.prim);
+
+    // Transforma la dirección de la luz y la dirección de la vista al espacio del objeto
+    glm::vec3 lightDirObjSpace = normalMatrix * glm::normalize(scene.light.position - intersect.point);
+    glm::vec3 viewDirObjSpace = normalMatrix * glm::normalize(rayOrigin - intersect.point);
+
+    glm::vec3 reflectDirObjSpace = glm::reflect(-lightDirObjSpace, intersect.normal);
+
+    float shadowIntensity = castShadow(scene, intersect.point, lightDirObjSpace, hit.prim);
+
+    float diffuseLightIntensity = glm::max(0.0f, glm::dot(intersect.normal, lightDirObjSpace));
+
+    // Reflección y refracción
+    Color reflectedColor(0.0f, 0.0f, 0.0f);
+    if (material.reflectivity > 0) {
+        glm::vec3 origin = intersect.point + intersect.normal * BIAS;
+        glm::vec3 reflectedRayDirObjSpace = normalMatrix * reflectDirObjSpace;
+        reflectedColor = castRay(scene, origin, reflectedRayDirObjSpace, recursion + 1);
+    }
+
+    Color refractedColor(0.0f, 0.0f, 0.0f);
+    if (material.transparency > 0) {
+        glm::vec3 origin = intersect.point - intersect.normal * BIAS;
+        glm::vec3 refractDirObjSpace = normalMatrix * glm::refract(rayDirection, intersect.normal, material.refractionIndex);
+        refractedColor = castRay(scene, origin, refractDirObjSpace, recursion + 1);
+    }
+
+    Color diffusecolor;
+    if (material.texture != nullptr) {
+        diffusecolor = material.texture->sample(intersect.tx, intersect.ty);
+    } else {
+        diffusecolor = material.diffuse;
+    }
+
+    // Cálculos de luz difusa y especular
+    ViewIndependentShading local;
+    ViewIndependentShading& direct = terms != nullptr ? *terms : local;
+    direct.diffuse = diffusecolor * scene.light.intensity * diffuseLightIntensity * material.albedo * shadowIntensity;
+    direct.reflectDir = reflectDirObjSpace;
+    direct.shadow = shadowIntensity;
+
+    // Combinación de los componentes de iluminación y efectos
+    Color color = directLight(scene, material, direct, viewDirObjSpace) * (1.0f - material.reflectivity - material.transparency) + reflectedColor * material.reflectivity + refractedColor * material.transparency;
+    return color;
+}
+
+Color castRay(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const short recursion) {
+    SceneHit hit;
+    if (!closestHit(scene, rayOrigin, rayDirection, hit) || recursion == MAX_RECURSION) {
+        return {reinterpret_cast<char *>(char(0))};
+    }
+    return shade(scene, rayOrigin, rayDirection, hit, recursion);
+}
+
+void closestHitPacket(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3* rayDirections, int count, SceneHit* hits) {
+    float zBuffer[PACKET_SIZE * PACKET_SIZE];
+    glm::vec3 invDirs[PACKET_SIZE * PACKET_SIZE];
+    uint64_t active = 0;
+
+    // Un mundo en disco se recorre rayo por rayo
+    for (int i = 0; i < count; i++) {
+        zBuffer[i] = 99999;
+        invDirs[i] = 1.0f / rayDirections[i];
+        hits[i] = SceneHit();
+        active |= uint64_t(1) << i;
+
+        VoxelHit voxelHit;
+        if (scene.grid.isStreaming() && scene.grid.intersect(rayOrigin, rayDirections[i], 0.0f, zBuffer[i], voxelHit)) {
+            zBuffer[i] = voxelHit.t;
+            hits[i].prim = {PrimitiveKind::Voxel, 0, voxelHit.cell};
+        }
+    }
+
+    // Cada BVH una sola vez para todo el paquete; cada hoja la prueban solo los rayos que la alcanzan
+    scene.blockBvh.traversePacket(rayOrigin, invDirs, active, zBuffer, [&](uint32_t first, uint32_t leafCount, uint64_t mask, float* tMax) {
+        for (; mask != 0; mask &= mask - 1) {
+            int lane = std::countr_zero(mask);
+            testBlocks(scene, rayOrigin, invDirs[lane], first, leafCount, tMax[lane], hits[lane].prim);
+        }
+    });
+    scene.primitives.bvh.traversePacket(rayOrigin, invDirs, active, zBuffer, [&](uint32_t first, uint32_t leafCount, uint64_t mask, float* tMax) {
+        for (; mask != 0; mask &= mask - 1) {
+            int lane = std::countr_zero(mask);
+            scene.primitives.testLeaf(rayOrigin, rayDirections[lane], invDirs[lane], first, leafCount, tMax[lane], hits[lane].prim);
+        }
+    });
+
+    for (int i = 0; i < count; i++) {
+        hits[i].intersect = surfaceOf(scene, hits[i].prim, rayOrigin, rayDirections[i], zBuffer[i]);
+    }
+}
+
+void beginFrame(ThreadPool& pool, const Scene& scene, const Camera& camera, Framebuffer& target) {
+    Framebuffer* output = &target;
+    submitTiles(pool, scene, camera, target.getWidth(), target.getHeight(), glm::vec2(0.5f), nullptr, CancelToken(),
+                [output](int x, int y, const Color& color, const SceneHit* hit, const ViewIndependentShading&) {
+        if (hit != nullptr) {
+            output->setPixel(x, y, color);
+        } else {
+            output->clearPixel(x, y);
+        }
+    });
+}
+
+void beginRefinePass(ThreadPool& pool, const Scene& scene, const Camera& camera, Accumulator& accumulator, Framebuffer& target,
+                     CancelToken cancel, ReprojectionCache* surfaces) {
+    const Scene* tracedScene = &scene;
+    Accumulator* samples = &accumulator;
+    Framebuffer* output = &target;
+    int sample = accumulator.beginSample();
+    if (sample != 0) {
+        surfaces = nullptr;
+    }
+    submitTiles(pool, scene, camera, target.getWidth(), target.getHeight(), samplePosition(sample), nullptr, cancel,
+                [tracedScene, samples, output, surfaces, sample](int x, int y, const Color& color, const SceneHit* hit, const ViewIndependentShading& terms) {
+        Color average = samples->add(x, y, sample, color, hit != nullptr);
+        output->setPixel(x, y, average, average.a);
+        if (surfaces != nullptr) {
+            recordSurface(*tracedScene, *surfaces, x, y, hit, terms);
+        }
+    });
+}
+
+void beginFillPass(ThreadPool& pool, const Scene& scene, const Camera& camera, const std::vector<uint8_t>& holes,
+                   Framebuffer& target, ReprojectionCache& surfaces, CancelToken cancel) {
+    const Scene* tracedScene = &scene;
+    Framebuffer* output = &target;
+    ReprojectionCache* recorded = &surfaces;
+    submitTiles(pool, scene, camera, target.getWidth(), target.getHeight(), glm::vec2(0.5f), holes.data(), cancel,
+                [tracedScene, output, recorded](int x, int y, const Color& color, const SceneHit* hit, const ViewIndependentShading& terms) {
+        if (hit != nullptr) {
+            output->setPixel(x, y, color);
+        } else {
+            output->clearPixel(x, y);
+        }
+        recordSurface(*tracedScene, *recorded, x, y, hit, terms);
+    });
+}
+
+void traceFrame(ThreadPool& pool, const Scene& scene, const Camera& camera, Framebuffer& target) {
+    beginFrame(pool, scene, camera, target);
+    pool.wait();
+    target.swap();
+}
+
+ImageData renderStill(ThreadPool& pool, const Scene& scene, const Camera& camera, int width, int height, int samples) {
+    Framebuffer image(width, height);
+    if (samples <= 1) {
+        traceFrame(pool, scene, camera, image);
+    } else {
+        Accumulator accumulator(width, height);
+        for (int i = 0; i < samples; i++) {
+            beginRefinePass(pool, scene, camera, accumulator, image);
+            pool.wait();
+        }
+        image.swap();
+    }
+
+    // Sin renderer no hay capa de fondo: los pixeles sin objeto o cubiertos en parte lo mezclan
+    // con la busqueda de entorno
+    ImageData still{width, height, image.frontPixels()};
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = &still.rgba[(static_cast<size_t>(y) * width + x) * 4];
+            if (p[3] < 255) {
+                Color env = scene.background.sample((x + 0.5f) / width, (y + 0.5f) / height);
+                float coverage = p[3] / 255.0f;
+                p[0] = static_cast<uint8_t>(p[0] * coverage + env.r * (1.0f - coverage) + 0.5f);
+                p[1] = static_cast<uint8_t>(p[1] * coverage + env.g * (1.0f - coverage) + 0.5f);
+                p[2] = static_cast<uint8_t>(p[2] * coverage + env.b * (1.0f - coverage) + 0.5f);
+                p[3] = 255;
+            }
+        }
+    }
+    return still;
+}
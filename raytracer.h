@@ -0,0 +1,92 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "color.h"
+#include "camera.h"
+#include "scene.h"
+#include "framebuffer.h"
+#include "accumulator.h"
+#include "threadpool.h"
+#include "image.h"
+#include <atomic>
+#include <cstdint>
+
+const int MAX_RECURSION = 1;
+const float BIAS = 0.0001f;
+const float FOV = 3.1415f/3.0f;
+const int TILE_SIZE = 16;
+const int PACKET_SIZE = 8;  // paquetes de 8x8 rayos primarios: un bit por rayo en un uint64_t
+const int MAX_REFINE_SAMPLES = 64;  // muestras por pixel del refinamiento progresivo con la camara quieta
+
+// Permite abandonar un pase en curso: cuando 'current' deja de valer 'generation' los hilos
+// dejan de trazar paquetes nuevos, asi el pase termina tras lo que ya estaba en vuelo
+struct CancelToken {
+    const std::atomic<uint64_t>* current = nullptr;
+    uint64_t generation = 0;
+
+    bool cancelled() const { return current != nullptr && current->load(std::memory_order_relaxed) != generation; }
+};
+
+class ReprojectionCache;
+
+// Terminos de shade() que no dependen de la camara. Con ellos se vuelve a iluminar un corte visto
+// desde otra posicion sin lanzar rayos (ver ReprojectionCache).
+struct ViewIndependentShading {
+    Color diffuse;                // luz difusa con la sombra ya aplicada
+    glm::vec3 reflectDir{0.0f};   // luz reflejada, en espacio del objeto
+    float shadow = 0.0f;
+};
+
+// Corte mas cercano de un rayo: la superficie y el primitivo (o la celda de la malla) que la produjo
+struct SceneHit {
+    Intersect intersect;
+    PrimitiveRef prim;
+};
+
+// Factor de luz en [0, 1]: 1 si nada tapa la luz, menos mientras mas lejos del punto este el bloqueador
+float castShadow(const Scene& scene, const glm::vec3& shadowOrigin, const glm::vec3& lightDir, const PrimitiveRef& hitPrim);
+
+// Busca el corte mas cercano del rayo en la malla de voxeles y en el BVH
+bool closestHit(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, SceneHit& hit);
+
+// Igual que closestHit para un paquete de hasta PACKET_SIZE x PACKET_SIZE rayos con el mismo
+// origen: el BVH se recorre una vez para todo el paquete. Sin corte, hits[i].intersect.isIntersecting es falso.
+void closestHitPacket(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3* rayDirections, int count, SceneHit* hits);
+
+// Ilumina un corte: sombra, difuso, especular, reflexion y refraccion. Con 'terms' devuelve
+// ademas la parte que no depende de la camara.
+Color shade(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const SceneHit& hit, const short recursion = 0,
+            ViewIndependentShading* terms = nullptr);
+
+// Difuso + especular para una direccion de vista en espacio del objeto. En materiales sin reflexion
+// ni refraccion es exactamente el color de shade().
+Color directLight(const Scene& scene, const Material& material, const ViewIndependentShading& terms, const glm::vec3& viewDirObjSpace);
+
+// Color del rayo; si no golpea nada devuelve el color centinela con i == 1
+Color castRay(const Scene& scene, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const short recursion = 0);
+
+// Empieza a trazar el cuadro en el buffer trasero de 'target', repartiendo tiles de
+// TILE_SIZE x TILE_SIZE entre los hilos del pool. Vuelve enseguida; pool.wait() lo termina.
+// La escena y la camara se leen desde los hilos hasta entonces.
+void beginFrame(ThreadPool& pool, const Scene& scene, const Camera& camera, Framebuffer& target);
+
+// Un pase de refinamiento progresivo: una muestra mas por pixel, con el rayo desplazado dentro
+// del pixel, sumada en 'accumulator'. El promedio va al buffer trasero de 'target' con alfa igual a
+// la fraccion de muestras que golpearon algo. La primera muestra tras accumulator.reset() pasa por
+// el centro del pixel y cuesta lo mismo que beginFrame. Vuelve enseguida, igual que beginFrame.
+// Si 'cancel' se cancela el pase queda a medias y no hay que mostrarlo. Con 'surfaces' la primera
+// muestra anota lo que ve cada pixel para reproyectarlo despues.
+void beginRefinePass(ThreadPool& pool, const Scene& scene, const Camera& camera, Accumulator& accumulator, Framebuffer& target,
+                     CancelToken cancel = {}, ReprojectionCache* surfaces = nullptr);
+
+// Traza por el centro solo los pixeles marcados en 'holes' (ReprojectionCache::reproject) y los
+// anota en 'surfaces'; el resto del buffer trasero de 'target' queda con lo reproyectado.
+void beginFillPass(ThreadPool& pool, const Scene& scene, const Camera& camera, const std::vector<uint8_t>& holes,
+                   Framebuffer& target, ReprojectionCache& surfaces, CancelToken cancel = {});
+
+// beginFrame + wait + swap: al volver el cuadro esta en el buffer delantero
+void traceFrame(ThreadPool& pool, const Scene& scene, const Camera& camera, Framebuffer& target);
+
+// Cuadro completo de width x height con el fondo en los pixeles sin objeto. Con samples > 1
+// promedia ese numero de pases de refinamiento (bordes suavizados).
+ImageData renderStill(ThreadPool& pool, const Scene& scene, const Camera& camera, int width, int height, int samples = 1);
@@ -0,0 +1,108 @@
+#include "renderjob.h"
+
+RenderJob::RenderJob(ThreadPool& pool, Scene& scene, const Camera& camera, Framebuffer& target, float frameBudgetMs)
+        : pool(pool), scene(scene), camera(camera), target(target), resolution(frameBudgetMs),
+          lowRes(1, 1), accumulator(target.getWidth(), target.getHeight()),
+          surfaces(target.getWidth(), target.getHeight()),
+          passSize(target.getWidth(), target.getHeight()) {
+}
+
+RenderJob::~RenderJob() {
+    // Los hilos leen la escena, la camara y el acumulador hasta terminar el pase
+    generation++;
+    pool.wait();
+}
+
+void RenderJob::restart(const Camera& camera, bool sceneChanged) {
+    this->camera = camera;
+    generation++;
+    restartPending = true;
+    this->sceneChanged = this->sceneChanged || sceneChanged;
+}
+
+void RenderJob::startOver(const glm::ivec2& size) {
+    if (size != passSize) {
+        passSize = size;
+        if (size != glm::ivec2(target.getWidth(), target.getHeight())) {
+            lowRes = Framebuffer(size.x, size.y);
+        }
+        accumulator = Accumulator(size.x, size.y);
+    }
+    accumulator.reset();
+}
+
+bool RenderJob::poll() {
+    const glm::ivec2 fullSize(target.getWidth(), target.getHeight());
+    const int fullPixels = fullSize.x * fullSize.y;
+    bool published = false;
+    if (running) {
+        if (!pool.idle()) {
+            return false;
+        }
+        running = false;
+
+        double ms = std::chrono::duration<double, std::milli>(pool.finishedAt() - passStart).count();
+        if (!restartPending) {
+            resolution.addSample(ms, passPixels, fullPixels);
+            if (pass == Pass::LowRes) {
+                lowRes.swap();
+                target.upscaleFrom(lowRes);
+                surfaces.invalidate();
+            } else if (passRecords) {
+                surfaces.swap();
+            }
+            target.swap();
+            published = true;
+        } else if (ms > resolution.getTarget()) {
+            // Cancelado despues de pasarse del presupuesto: el costo real es al menos este
+            resolution.addSample(ms, passPixels, fullPixels);
+        }
+    }
+
+    const Pass finished = pass;
+    // Con los hilos quietos: si se movio un objeto, lo acumulado y el cuadro mostrado no valen,
+    // tambien con la camara quieta
+    if (scene.updateTransforms()) {
+        restartPending = true;
+        sceneChanged = true;
+    }
+    if (restartPending) {
+        restartPending = false;
+        scene.updateStreaming(camera);
+        if (sceneChanged) {
+            sceneChanged = false;
+            surfaces.invalidate();
+        }
+
+        // Con movimiento primero se reutiliza el cuadro mostrado; si quedan demasiados pixeles
+        // por trazar para el presupuesto, se baja la resolucion
+        if (surfaces.hasFrame()) {
+            int holeCount = surfaces.reproject(scene, camera, target, holes);
+            if (resolution.estimateMs(holeCount) <= resolution.getTarget()) {
+                pass = Pass::Fill;
+                passPixels = holeCount;
+                passRecords = true;
+                passStart = std::chrono::steady_clock::now();
+                beginFillPass(pool, scene, camera, holes, target, surfaces, CancelToken{&generation, generation.load()});
+                running = true;
+                return published;
+            }
+        }
+        startOver(resolution.resolution(fullSize.x, fullSize.y));
+    } else if (published && finished != Pass::Refine) {
+        // Camara quieta: el refinamiento sigue a resolucion completa desde la primera muestra
+        startOver(fullSize);
+    }
+
+    if (accumulator.getSampleCount() < MAX_REFINE_SAMPLES) {
+        bool full = passSize == fullSize;
+        pass = full ? Pass::Refine : Pass::LowRes;
+        passPixels = passSize.x * passSize.y;
+        passRecords = full && accumulator.getSampleCount() == 0;
+        passStart = std::chrono::steady_clock::now();
+        beginRefinePass(pool, scene, camera, accumulator, full ? target : lowRes, CancelToken{&generation, generation.load()},
+                        passRecords ? &surfaces : nullptr);
+        running = true;
+    }
+    return published;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "accumulator.h"
+#include "camera.h"
+#include "framebuffer.h"
+#include "raytracer.h"
+#include "reprojection.h"
+#include "resolution.h"
+#include "scene.h"
+#include "threadpool.h"
+
+// Trazado en segundo plano para el visor. El hilo de la interfaz solo llama restart() al
+// recibir entrada y poll() una vez por vuelta; ninguno de los dos espera a los hilos.
+// Cada restart() sube un contador de generacion que cancela el pase en curso: los hilos
+// terminan el paquete que tienen en la mano y sueltan el resto del cuadro.
+// Tras un restart() primero se reproyecta el cuadro mostrado a la camara nueva y solo se trazan
+// los pixeles que no se pudieron reutilizar. Si son demasiados para el presupuesto de tiempo, el
+// pase va a la resolucion interna que cabe en el (ResolutionController) y se escala con filtro
+// bilineal al tamaño de 'target'. Con la camara quieta el refinamiento vuelve a resolucion completa.
+class RenderJob {
+public:
+    RenderJob(ThreadPool& pool, Scene& scene, const Camera& camera, Framebuffer& target, float frameBudgetMs = 33.0f);
+    ~RenderJob();
+
+    RenderJob(const RenderJob&) = delete;
+    RenderJob& operator=(const RenderJob&) = delete;
+
+    // Camara nueva o escena cambiada: descarta lo acumulado y vuelve a una muestra por pixel.
+    // Si cambio la escena el cuadro mostrado no se reproyecta.
+    void restart(const Camera& camera, bool sceneChanged = false);
+
+    // Si el pase en curso termino lo pasa al buffer delantero de 'target' (los cancelados no se
+    // muestran) y lanza el siguiente. Las matrices de la escena se actualizan aqui, con los hilos
+    // quietos; si un objeto se movio se empieza de nuevo como con restart(camera, true). Un
+    // objeto movido durante un pase aparece en el siguiente; restart() cancela el que corre.
+    // Devuelve true si hay un cuadro nuevo para mostrar.
+    bool poll();
+
+    // Todas las muestras hechas y los hilos quietos
+    bool converged() const { return !running && !restartPending && accumulator.getSampleCount() >= MAX_REFINE_SAMPLES; }
+    uint64_t getGeneration() const { return generation.load(); }
+
+    void setFrameBudget(float ms) { resolution.setTarget(ms); }
+    const ResolutionController& getResolution() const { return resolution; }
+
+private:
+    enum class Pass { Refine, LowRes, Fill };
+
+    // Vuelve a la primera muestra a 'size'; cambia los buffers internos si hace falta
+    void startOver(const glm::ivec2& size);
+
+    ThreadPool& pool;
+    Scene& scene;
+    Camera camera;
+    Framebuffer& target;
+    ResolutionController resolution;
+    Framebuffer lowRes;        // pases a menos resolucion que 'target', antes de escalarlos
+    Accumulator accumulator;   // del tamaño del pase
+    ReprojectionCache surfaces;
+    std::vector<uint8_t> holes;
+
+    Pass pass = Pass::Refine;
+    glm::ivec2 passSize;
+    int passPixels = 0;
+    bool passRecords = false;  // el pase anota superficies en 'surfaces'
+    std::chrono::steady_clock::time_point passStart;
+
+    std::atomic<uint64_t> generation{0};
+    bool restartPending = true;
+    bool sceneChanged = false;
+    bool running = false;
+};
@@ -0,0 +1,128 @@
+#include "reprojection.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Base de la camara y escala de pantalla; mismo calculo que los rayos primarios de raytracer.cpp
+    struct View {
+        glm::vec3 position;
+        glm::vec3 dir;
+        glm::vec3 x;
+        glm::vec3 y;
+        float scaleX;
+        float scaleY;
+
+        View(const Camera& camera, int width, int height) {
+            position = camera.position;
+            dir = glm::normalize(camera.target - camera.position);
+            x = glm::normalize(glm::cross(dir, camera.up));
+            y = glm::normalize(glm::cross(x, dir));
+            float tanHalfFov = std::tan(FOV / 2.0f);
+            scaleX = tanHalfFov * static_cast<float>(width) / static_cast<float>(height);
+            scaleY = tanHalfFov;
+        }
+
+        glm::vec3 ray(int px, int py, int width, int height) const {
+            float screenX = ((2.0f * (px + 0.5f)) / width - 1.0f) * scaleX;
+            float screenY = (-(2.0f * (py + 0.5f)) / height + 1.0f) * scaleY;
+            return glm::normalize(dir + x * screenX + y * screenY);
+        }
+    };
+}
+
+ReprojectionCache::ReprojectionCache(int width, int height)
+        : width(width), height(height),
+          front(static_cast<size_t>(width) * height), back(static_cast<size_t>(width) * height),
+          depth(static_cast<size_t>(width) * height), source(static_cast<size_t>(width) * height) {
+}
+
+void ReprojectionCache::swap() {
+    front.swap(back);
+    valid = true;
+}
+
+int ReprojectionCache::reproject(const Scene& scene, const Camera& camera, Framebuffer& target, std::vector<uint8_t>& holes) {
+    const size_t count = static_cast<size_t>(width) * height;
+    holes.assign(count, 1);
+    if (!valid) {
+        return static_cast<int>(count);
+    }
+
+    View view(camera, width, height);
+    std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::infinity());
+    std::fill(source.begin(), source.end(), -1);
+
+    // Cada superficie del cuadro anterior cae en un pixel del nuevo; gana la mas cercana
+    for (size_t i = 0; i < count; i++) {
+        const SurfaceSample& sample = front[i];
+        if (!(sample.flags & SurfaceSample::HIT)) {
+            continue;
+        }
+        glm::vec3 toPoint = sample.position - view.position;
+        float z = glm::dot(toPoint, view.dir);
+        if (z <= 0.0f || glm::dot(sample.normal, toPoint) >= 0.0f) {
+            continue;
+        }
+        float screenX = glm::dot(toPoint, view.x) / (z * view.scaleX);
+        float screenY = glm::dot(toPoint, view.y) / (z * view.scaleY);
+        int px = static_cast<int>(std::floor((screenX + 1.0f) * 0.5f * width));
+        int py = static_cast<int>(std::floor((1.0f - screenY) * 0.5f * height));
+        if (px < 0 || py < 0 || px >= width || py >= height) {
+            continue;
+        }
+        size_t pixel = static_cast<size_t>(py) * width + px;
+        float distance = glm::length(toPoint);
+        if (distance < depth[pixel]) {
+            depth[pixel] = distance;
+            source[pixel] = static_cast<int>(i);
+        }
+    }
+
+    // Un pixel de ancho a distancia 1
+    const float pixelAngle = 2.0f * view.scaleY / height;
+    int holeCount = 0;
+    for (int py = 0; py < height; py++) {
+        for (int px = 0; px < width; px++) {
+            size_t pixel = static_cast<size_t>(py) * width + px;
+            int from = source[pixel];
+            if (from < 0 || (front[from].flags & SurfaceSample::VIEW_DEPENDENT)) {
+                holeCount++;
+                continue;
+            }
+            const SurfaceSample& sample = front[from];
+
+            // Profundidad: si un vecino esta bastante mas cerca, esta superficie puede estar
+            // asomandose por un hueco de la que la tapa
+            float d = depth[pixel];
+            bool occluded = false;
+            for (int k = 0; k < 4 && !occluded; k++) {
+                int nx = px + (k == 0) - (k == 1);
+                int ny = py + (k == 2) - (k == 3);
+                if (nx >= 0 && ny >= 0 && nx < width && ny < height) {
+                    occluded = depth[static_cast<size_t>(ny) * width + nx] < d * 0.9f;
+                }
+            }
+
+            // Normal y posicion: el rayo por el centro del pixel tiene que cortar el plano de la
+            // superficie a menos de un par de pixeles del punto anotado
+            glm::vec3 ray = view.ray(px, py, width, height);
+            float facing = glm::dot(ray, sample.normal);
+            bool onPlane = false;
+            if (!occluded && facing < -1e-3f) {
+                float t = glm::dot(sample.position - view.position, sample.normal) / facing;
+                glm::vec3 hit = view.position + ray * t;
+                onPlane = glm::length(hit - sample.position) <= 2.0f * t * pixelAngle / -facing;
+            }
+            if (occluded || !onPlane) {
+                holeCount++;
+                continue;
+            }
+
+            glm::vec3 viewDir = glm::normalize(view.position - sample.position);
+            target.setPixel(px, py, directLight(scene, scene.materials[sample.material], sample.shading, viewDir));
+            back[pixel] = sample;
+            holes[pixel] = 0;
+        }
+    }
+    return holeCount;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "camera.h"
+#include "framebuffer.h"
+#include "intersect.h"
+#include "material.h"
+#include "raytracer.h"
+#include "scene.h"
+
+// Superficie que vio el rayo por el centro de un pixel y su luz sin la parte que depende de la vista
+struct SurfaceSample {
+    glm::vec3 position;
+    glm::vec3 normal;
+    ViewIndependentShading shading;
+    MaterialId material = NO_MATERIAL;
+    uint8_t flags = 0;
+
+    static const uint8_t HIT = 1;
+    static const uint8_t VIEW_DEPENDENT = 2;  // hay que trazarlo de nuevo: reflexion, refraccion o transformacion
+};
+
+// Posicion, normal y luz de lo que se ve en cada pixel del cuadro mostrado, para volver a
+// iluminarlo desde la camara nueva cuando esta se mueve en vez de trazarlo otra vez. Como el
+// Framebuffer, tiene un lado que escriben los hilos y otro que corresponde al buffer delantero.
+class ReprojectionCache {
+public:
+    ReprojectionCache(int width, int height);
+
+    // Los hilos anotan la superficie de un pixel del cuadro que se esta trazando
+    void record(int x, int y, const Intersect* hit, const ViewIndependentShading& shading, MaterialId material, bool viewDependent) {
+        SurfaceSample& sample = back[static_cast<size_t>(y) * width + x];
+        sample.flags = 0;
+        if (hit != nullptr) {
+            sample.position = hit->point;
+            sample.normal = hit->normal;
+            sample.shading = shading;
+            sample.material = material;
+            sample.flags = SurfaceSample::HIT | (viewDependent ? SurfaceSample::VIEW_DEPENDENT : 0);
+        }
+    }
+
+    // El cuadro anotado pasa a describir el buffer delantero
+    void swap();
+    // El buffer delantero ya no corresponde a lo anotado (otra resolucion o la escena cambio)
+    void invalidate() { valid = false; }
+    bool hasFrame() const { return valid; }
+
+    // Reproyecta el cuadro anotado a 'camera': proyecta cada superficie, se queda con la mas cercana
+    // por pixel y la valida contra el rayo por el centro del pixel nuevo (mismo plano segun posicion
+    // y normal) y contra la profundidad de sus vecinos. Lo valido se vuelve a iluminar con
+    // directLight() hacia la camara nueva y va al buffer trasero de 'target' y de la cache; el resto
+    // queda marcado en 'holes' para trazarlo. Devuelve cuantos pixeles hay que trazar.
+    int reproject(const Scene& scene, const Camera& camera, Framebuffer& target, std::vector<uint8_t>& holes);
+
+private:
+    int width;
+    int height;
+    std::vector<SurfaceSample> front;
+    std::vector<SurfaceSample> back;
+    bool valid = false;
+
+    // Memoria de trabajo de reproject()
+    std::vector<float> depth;
+    std::vector<int> source;
+};
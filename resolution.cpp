@@ -0,0 +1,30 @@
+#include "resolution.h"
+#include <algorithm>
+#include <cmath>
+
+ResolutionController::ResolutionController(float targetMs, float minScale, float maxScale)
+        : targetMs(targetMs), minScale(minScale), maxScale(maxScale), scale(maxScale) {
+}
+
+void ResolutionController::addSample(double ms, int pixels, int fullPixels) {
+    if (pixels <= 0 || fullPixels <= 0) {
+        return;
+    }
+
+    double cost = ms / pixels;
+    msPerPixel = msPerPixel == 0.0 ? cost : msPerPixel * 0.75 + cost * 0.25;
+
+    // Lado que cabe en el presupuesto: el area escala con el cuadrado
+    float fit = static_cast<float>(std::sqrt(targetMs / (msPerPixel * fullPixels)));
+    float step = std::floor(fit * STEPS) / STEPS;
+    step = std::clamp(step, minScale, maxScale);
+
+    // Baja enseguida si se pasa; sube solo con margen para no oscilar entre dos pasos
+    if (step < scale || fit > scale + 1.25f / STEPS) {
+        scale = step;
+    }
+}
+
+glm::ivec2 ResolutionController::resolution(int width, int height) const {
+    return glm::max(glm::ivec2(glm::round(glm::vec2(width, height) * scale)), glm::ivec2(1));
+}
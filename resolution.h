@@ -0,0 +1,33 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+// Elige la resolucion interna del trazado para que un pase quepa en un presupuesto de tiempo.
+// Estima el costo por pixel con un promedio movil de los pases medidos y de ahi saca la
+// fraccion del lado de la ventana, en pasos de 1/STEPS para no cambiar de tamaño cada cuadro.
+class ResolutionController {
+public:
+    static const int STEPS = 8;
+
+    explicit ResolutionController(float targetMs, float minScale = 0.25f, float maxScale = 1.0f);
+
+    void setTarget(float ms) { targetMs = ms; }
+    float getTarget() const { return targetMs; }
+
+    // Un pase de 'pixels' pixeles tardo 'ms'. 'fullPixels' es el area de la ventana.
+    void addSample(double ms, int pixels, int fullPixels);
+
+    // Tiempo estimado para trazar 'pixels' pixeles, 0 sin mediciones
+    double estimateMs(int pixels) const { return msPerPixel * pixels; }
+
+    float getScale() const { return scale; }
+    // Resolucion interna para una ventana de width x height, al menos 1x1
+    glm::ivec2 resolution(int width, int height) const;
+
+private:
+    float targetMs;
+    float minScale;
+    float maxScale;
+    float scale;
+    double msPerPixel = 0.0;
+};
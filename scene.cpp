@@ -0,0 +1,161 @@
+#include "scene.h"
+#include "cube.h"
+#include "instance.h"
+#include <chrono>
+
+namespace {
+    // Cuanto puede crecer el costo SAH por refit antes de reconstruir el BVH de los objetos
+    const float REBUILD_COST_GROWTH = 1.3f;
+}
+
+Scene::Scene(ImageDecoder decoder) : textures(decoder), decoder(decoder) {
+}
+
+Scene::~Scene() {
+    // El hilo de la reconstruccion lee los objetos
+    if (rebuild.valid()) {
+        rebuild.wait();
+    }
+    for (auto& object : objects) {
+        delete object;
+    }
+}
+
+void Scene::build() {
+    if (rebuild.valid()) {
+        rebuild.get();
+    }
+    movedDuringRebuild.clear();
+
+    buildVoxelGrid();
+    buildBlocks();
+    // Las cajas de las instancias salen de sus matrices
+    for (auto& object : objects) {
+        object->updateTransform();
+    }
+    primitives.build(objects);
+}
+
+bool Scene::updateTransforms() {
+    // Solo las instancias llevan su geometria con la transformacion; en cubos y esferas se ignora
+    std::vector<uint32_t> moved;
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        if (objects[i]->isTransformDirty()) {
+            objects[i]->updateTransform();
+            if (dynamic_cast<const Instance*>(objects[i]) != nullptr) {
+                moved.push_back(i);
+            }
+        }
+    }
+
+    bool adopted = false;
+    if (rebuild.valid()) {
+        if (rebuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // El arbol nuevo usa las cajas de antes: estos objetos se ajustan al adoptarlo
+            movedDuringRebuild.insert(movedDuringRebuild.end(), moved.begin(), moved.end());
+        } else {
+            primitives = std::move(*rebuild.get());
+            moved.insert(moved.end(), movedDuringRebuild.begin(), movedDuringRebuild.end());
+            movedDuringRebuild.clear();
+            adopted = true;
+        }
+    }
+    if (moved.empty()) {
+        return adopted;
+    }
+    primitives.refit(objects, moved);
+
+    // Las cajas se copian ahora; el otro hilo no lee transformaciones
+    if (!rebuild.valid() && primitives.costGrowth() > REBUILD_COST_GROWTH) {
+        rebuild = std::async(std::launch::async, [objects = objects, bounds = primitives.getBounds()]() mutable {
+            auto rebuilt = std::make_unique<PrimitiveSet>();
+            rebuilt->build(objects, std::move(bounds));
+            return rebuilt;
+        });
+    }
+    return true;
+}
+
+void Scene::updateStreaming(const Camera& camera) {
+    if (ChunkedWorld* world = grid.getWorld()) {
+        world->updateResidency(camera.position, glm::normalize(camera.target - camera.position));
+    }
+}
+
+bool Scene::occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax,
+                     const PrimitiveRef& skip, float& t) const {
+    const float tMin = std::numeric_limits<float>::min();
+    glm::vec3 invDir = 1.0f / rayDirection;
+
+    // La sombra depende de la distancia, asi que cuenta el bloqueador mas cercano: el primitivo
+    // solo gana si esta antes que el bloque
+    float blockT = tMax;
+    bool blocked = false;
+    if (grid.isStreaming()) {
+        blocked = grid.occluded(rayOrigin, rayDirection, tMin, tMax, blockT, skip.kind == PrimitiveKind::Voxel ? &skip.cell : nullptr);
+    } else {
+        uint32_t skipBlock = skip.kind == PrimitiveKind::Block ? skip.index : BoxSet::NO_SKIP;
+        blockBvh.traverseLeaves(rayOrigin, rayDirection, blockT, [&](uint32_t first, uint32_t count, float& limit) {
+            blocked = blocks.boxes.nearest(rayOrigin, invDir, first, count, tMin, limit, skipBlock) >= 0 || blocked;
+        });
+    }
+
+    if (primitives.occluded(rayOrigin, rayDirection, blockT, skip, t)) {
+        return true;
+    }
+    if (blocked) {
+        t = blockT;
+    }
+    return blocked;
+}
+
+MaterialId Scene::materialIdOf(const PrimitiveRef& prim) const {
+    switch (prim.kind) {
+        case PrimitiveKind::Voxel:
+            return grid.get(prim.cell);
+        case PrimitiveKind::Block:
+            return blocks.cells[prim.index].materialId;
+        default:
+            return primitives.materialIdOf(prim);
+    }
+}
+
+glm::mat3 Scene::normalMatrixOf(const PrimitiveRef& prim) const {
+    return primitives.normalMatrixOf(prim);
+}
+
+void Scene::buildVoxelGrid() {
+    // Un mundo en disco no se modifica: los cubos quedan en el BVH
+    if (grid.getWorld() != nullptr) {
+        return;
+    }
+    std::vector<Object*> remaining;
+    for (Object* object : objects) {
+        auto* cube = dynamic_cast<Cube*>(object);
+        if (cube != nullptr && cube->isUnitVoxel()) {
+            grid.set(glm::ivec3(cube->getCenter()), cube->material);
+            delete cube;
+        } else {
+            remaining.push_back(object);
+        }
+    }
+    objects = std::move(remaining);
+}
+
+void Scene::buildBlocks() {
+    blocks = BlockArray();
+    std::vector<BlockBox> merged = grid.mergeBlocks(materials);
+
+    std::vector<AABB> bounds;
+    bounds.reserve(merged.size());
+    for (const BlockBox& box : merged) {
+        bounds.push_back(AABB{glm::vec3(box.min) - 0.5f, glm::vec3(box.max) + 0.5f});
+    }
+    blockBvh.build(bounds, BoxSet::WIDTH);
+
+    // Un solo tipo de primitivo: la hoja [first, first + count) son esas mismas cajas
+    for (uint32_t index : blockBvh.leafOrder()) {
+        blocks.boxes.add(bounds[index]);
+        blocks.cells.push_back(merged[index]);
+    }
+}
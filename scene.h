@@ -0,0 +1,89 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+#include "object.h"
+#include "light.h"
+#include "bvh.h"
+#include "boxset.h"
+#include "primitiveset.h"
+#include "voxelgrid.h"
+#include "texture.h"
+#include "background.h"
+#include "camera.h"
+#include "image.h"
+
+// Bloques de la malla juntados en cajas por VoxelGrid::mergeBlocks, en el orden de las hojas
+// de Scene::blockBvh: la caja para probar 8 a la vez y sus celdas para la superficie
+struct BlockArray {
+    BoxSet boxes;
+    std::vector<BlockBox> cells;
+};
+
+// Todo lo que se traza: objetos, estructuras de aceleracion, luz, texturas y fondo
+class Scene {
+public:
+    explicit Scene(ImageDecoder decoder = nullptr);
+    ~Scene();
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    const Texture* loadTexture(const std::string& file) { return textures.load(file); }
+    bool loadBackground(const std::string& file) { return background.load(file, decoder); }
+
+    // Pasa los cubos unitarios alineados a la malla a 'grid', cuyas celdas se juntan en cajas con
+    // su propio BVH (un mundo en disco se recorre celda por celda), y compila el resto de
+    // 'objects' en otro BVH con arreglos contiguos por tipo. Un Instance entra como una hoja que
+    // apunta a un Model compilado aparte. Mover instancias solo pide updateTransforms(); agregar
+    // o quitar objetos pide volver a llamarla.
+    void build();
+    // Actualiza las matrices de los objetos que se movieron y ajusta en el BVH (refit) las cajas
+    // de las instancias, sin reconstruirlo; cubos y esferas no siguen su transformacion. Si el
+    // costo SAH del arbol crece demasiado, lo reconstruye en otro hilo y lo adopta en una llamada
+    // posterior. Devuelve true si alguna instancia se movio o se adopto un arbol nuevo: el cuadro
+    // anterior ya no vale. Se llama con los hilos quietos, antes de trazar.
+    bool updateTransforms();
+    // Si la malla sale de un mundo en disco, pide los chunks que va a ver 'camera' y suelta los
+    // que no se usan. Tambien con los hilos quietos.
+    void updateStreaming(const Camera& camera);
+
+    // Consulta de oclusion para sombras: busca el bloqueador mas cercano con 0 < t < tMax entre
+    // bloques y primitivos, sin calcular normales ni uv, e ignora el primitivo de donde sale el
+    // rayo. 't' recibe su distancia, que castShadow usa para la penumbra.
+    bool occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMax,
+                  const PrimitiveRef& skip, float& t) const;
+
+    // Material y matriz de normales de un primitivo compilado; los voxeles no tienen transformacion
+    MaterialId materialIdOf(const PrimitiveRef& prim) const;
+    const Material& materialOf(const PrimitiveRef& prim) const { return materials[materialIdOf(prim)]; }
+    glm::mat3 normalMatrixOf(const PrimitiveRef& prim) const;
+
+    std::vector<Object*> objects;
+    VoxelGrid grid;
+
+    // Bloques de 'grid' compilados en cajas; vacio si la malla sale de un mundo en disco
+    BVH blockBvh;
+    BlockArray blocks;
+
+    // Objetos compilados: cubos, esferas, otros objetos e instancias de modelos bajo un solo BVH
+    PrimitiveSet primitives;
+    MaterialTable materials;  // unica copia de cada material; objetos y voxeles guardan su id
+    Light light = {glm::vec3(-10.0, 0, 10), 1.0f, Color(255, 255, 255)};
+    TextureStore textures;
+    Background background;
+
+private:
+    void buildVoxelGrid();
+    void buildBlocks();
+
+    ImageDecoder decoder;
+
+    // Reconstruccion de 'primitives' en segundo plano e indices de los objetos que se movieron
+    // desde que se tomaron sus cajas
+    std::future<std::unique_ptr<PrimitiveSet>> rebuild;
+    std::vector<uint32_t> movedDuringRebuild;
+};
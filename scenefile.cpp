@@ -0,0 +1,538 @@
+#include "scenefile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <span>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include "chunkedworld.h"
+#include "cube.h"
+#include "mappedfile.h"
+#include "sphere.h"
+
+namespace {
+    const char MAGIC[8] = {'P', '3', 'S', 'C', 'E', 'N', 'E', '\0'};
+    const uint32_t VERSION = 2;
+
+    static_assert(sizeof(MaterialRecord) == 32 && sizeof(BlockRecord) == 16 && sizeof(ShapeRecord) == 20 &&
+                  sizeof(CameraRecord) == 40, "scene records must match the binary layout");
+
+    // Cabecera de la forma binaria. Cada seccion empieza en un multiplo de 8; la de cadenas
+    // tiene el fondo, el mundo y luego las texturas, cada una como longitud uint32 y sus bytes.
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t hasCamera;
+        float lightPosition[3];
+        float lightIntensity;
+        uint8_t lightColor[4];
+        CameraRecord camera;
+        uint32_t textureCount;
+        uint64_t stringsOffset, stringsSize;
+        uint64_t materialsOffset, materialCount;
+        uint64_t blocksOffset, blockCount;
+        uint64_t cubesOffset, cubeCount;
+        uint64_t spheresOffset, sphereCount;
+    };
+
+    // Lo que se arma en la Scene, venga de texto o de las secciones del archivo proyectado
+    struct SceneView {
+        std::string background;
+        std::string world;
+        std::vector<std::string> textures;
+        std::span<const MaterialRecord> materials;
+        Light light;
+        bool hasCamera = false;
+        CameraRecord camera = {};
+        std::span<const BlockRecord> blocks;
+        std::span<const ShapeRecord> cubes;
+        std::span<const ShapeRecord> spheres;
+    };
+
+    SceneView viewOf(const SceneFile& file) {
+        SceneView view;
+        view.background = file.background;
+        view.world = file.world;
+        view.textures = file.textures;
+        view.materials = file.materials;
+        view.light = file.light;
+        view.hasCamera = file.hasCamera;
+        view.camera = file.camera;
+        view.blocks = file.blocks;
+        view.cubes = file.cubes;
+        view.spheres = file.spheres;
+        return view;
+    }
+
+    bool isBinary(const MappedFile& mapped) {
+        return mapped.size() >= sizeof(MAGIC) && std::memcmp(mapped.data(), MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    // Seccion de 'count' registros de T dentro del archivo
+    template <typename T>
+    bool section(const MappedFile& mapped, uint64_t offset, uint64_t count, std::span<const T>& out) {
+        if (offset % alignof(T) != 0 || offset > mapped.size() || count > (mapped.size() - offset) / sizeof(T)) {
+            return false;
+        }
+        out = std::span<const T>(reinterpret_cast<const T*>(mapped.data() + offset), static_cast<size_t>(count));
+        return true;
+    }
+
+    bool readString(const uint8_t*& cursor, const uint8_t* end, std::string& out) {
+        uint32_t length;
+        if (end - cursor < static_cast<ptrdiff_t>(sizeof(length))) {
+            return false;
+        }
+        std::memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if (static_cast<uint64_t>(end - cursor) < length) {
+            return false;
+        }
+        out.assign(reinterpret_cast<const char*>(cursor), length);
+        cursor += length;
+        return true;
+    }
+
+    bool parseBinary(const std::string& file, const MappedFile& mapped, SceneView& view) {
+        BinaryHeader header;
+        if (mapped.size() < sizeof(header)) {
+            std::cerr << file << ": truncated scene header" << std::endl;
+            return false;
+        }
+        std::memcpy(&header, mapped.data(), sizeof(header));
+        if (header.version != VERSION) {
+            std::cerr << file << ": unsupported scene version " << header.version << std::endl;
+            return false;
+        }
+
+        std::span<const uint8_t> strings;
+        if (!section(mapped, header.stringsOffset, header.stringsSize, strings) ||
+            !section(mapped, header.materialsOffset, header.materialCount, view.materials) ||
+            !section(mapped, header.blocksOffset, header.blockCount, view.blocks) ||
+            !section(mapped, header.cubesOffset, header.cubeCount, view.cubes) ||
+            !section(mapped, header.spheresOffset, header.sphereCount, view.spheres)) {
+            std::cerr << file << ": scene section out of bounds" << std::endl;
+            return false;
+        }
+
+        // Cada cadena lleva al menos su largo de 4 bytes: una cuenta mayor no cabe en la tabla
+        if (header.textureCount > strings.size() / sizeof(uint32_t)) {
+            std::cerr << file << ": truncated string table" << std::endl;
+            return false;
+        }
+        const uint8_t* cursor = strings.data();
+        const uint8_t* end = cursor + strings.size();
+        view.textures.resize(header.textureCount);
+        bool stringsOk = readString(cursor, end, view.background) && readString(cursor, end, view.world);
+        for (std::string& texture : view.textures) {
+            stringsOk = stringsOk && readString(cursor, end, texture);
+        }
+        if (!stringsOk) {
+            std::cerr << file << ": truncated string table" << std::endl;
+            return false;
+        }
+
+        view.light.position = glm::vec3(header.lightPosition[0], header.lightPosition[1], header.lightPosition[2]);
+        view.light.intensity = header.lightIntensity;
+        view.light.color = Color(header.lightColor[0], header.lightColor[1], header.lightColor[2], header.lightColor[3]);
+        view.hasCamera = header.hasCamera != 0;
+        view.camera = header.camera;
+        return true;
+    }
+
+    std::string resolvePath(const std::string& sceneFile, const std::string& path) {
+        std::filesystem::path relative(path);
+        if (relative.is_absolute()) {
+            return path;
+        }
+        return (std::filesystem::path(sceneFile).parent_path() / relative).string();
+    }
+
+    bool instantiate(const std::string& file, const SceneView& view, Scene& scene, Camera& camera) {
+        if (view.materials.size() >= std::numeric_limits<MaterialId>::max()) {
+            std::cerr << file << ": too many materials (" << view.materials.size() << ")" << std::endl;
+            return false;
+        }
+
+        if (!view.background.empty()) {
+            scene.loadBackground(resolvePath(file, view.background));
+        }
+
+        std::vector<const Texture*> textures;
+        textures.reserve(view.textures.size());
+        for (const std::string& texture : view.textures) {
+            textures.push_back(scene.loadTexture(resolvePath(file, texture)));
+        }
+
+        // Indice de material del archivo -> id en la tabla de la escena
+        std::vector<MaterialId> ids;
+        ids.reserve(view.materials.size());
+        for (const MaterialRecord& record : view.materials) {
+            if (record.texture < -1 || record.texture >= static_cast<int32_t>(textures.size())) {
+                std::cerr << file << ": material references missing texture " << record.texture << std::endl;
+                return false;
+            }
+            ids.push_back(scene.materials.add({
+                    Color(record.color[0], record.color[1], record.color[2], record.color[3]),
+                    record.albedo,
+                    record.specularAlbedo,
+                    record.specularCoefficient,
+                    record.reflectivity,
+                    record.transparency,
+                    record.refractionIndex,
+                    record.texture >= 0 ? textures[record.texture] : nullptr
+            }));
+        }
+
+        scene.light = view.light;
+        if (!view.world.empty() && !scene.grid.stream(resolvePath(file, view.world), ids)) {
+            return false;
+        }
+        if (view.hasCamera) {
+            const CameraRecord& c = view.camera;
+            camera = Camera(glm::vec3(c.position[0], c.position[1], c.position[2]),
+                            glm::vec3(c.target[0], c.target[1], c.target[2]),
+                            glm::vec3(c.up[0], c.up[1], c.up[2]), c.rotationSpeed);
+        }
+
+        // Si la malla es un mundo en disco los bloques van como cubos
+        for (const BlockRecord& block : view.blocks) {
+            if (block.material >= ids.size()) {
+                std::cerr << file << ": block references missing material " << block.material << std::endl;
+                return false;
+            }
+            glm::ivec3 cell(block.x, block.y, block.z);
+            if (scene.grid.getWorld() != nullptr) {
+                scene.objects.push_back(new Cube(glm::vec3(cell), 1.0f, ids[block.material]));
+            } else {
+                scene.grid.set(cell, ids[block.material]);
+            }
+        }
+
+        for (const ShapeRecord& cube : view.cubes) {
+            if (cube.material >= ids.size()) {
+                std::cerr << file << ": cube references missing material " << cube.material << std::endl;
+                return false;
+            }
+            scene.objects.push_back(new Cube(glm::vec3(cube.x, cube.y, cube.z), cube.size, ids[cube.material]));
+        }
+        for (const ShapeRecord& sphere : view.spheres) {
+            if (sphere.material >= ids.size()) {
+                std::cerr << file << ": sphere references missing material " << sphere.material << std::endl;
+                return false;
+            }
+            scene.objects.push_back(new Sphere(glm::vec3(sphere.x, sphere.y, sphere.z), sphere.size, ids[sphere.material]));
+        }
+        return true;
+    }
+
+    template <typename T>
+    void writeSection(std::ofstream& out, uint64_t& offset, std::span<const T> records) {
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+        offset += records.size_bytes();
+    }
+
+    void pad(std::ofstream& out, uint64_t& offset) {
+        static const char zeros[8] = {};
+        uint64_t aligned = (offset + 7) & ~uint64_t(7);
+        out.write(zeros, static_cast<std::streamsize>(aligned - offset));
+        offset = aligned;
+    }
+
+    void putString(std::vector<uint8_t>& out, const std::string& text) {
+        uint32_t length = static_cast<uint32_t>(text.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&length);
+        out.insert(out.end(), bytes, bytes + sizeof(length));
+        out.insert(out.end(), text.begin(), text.end());
+    }
+}
+
+bool readSceneText(const std::string& file, SceneFile& scene) {
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "Cannot open " << file << std::endl;
+        return false;
+    }
+
+    scene = SceneFile();
+    std::unordered_map<std::string, int32_t> textureNames;
+    std::unordered_map<std::string, uint32_t> materialNames;
+    bool hasLight = false;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) {
+            continue;
+        }
+
+        bool reported = false;
+        auto fail = [&](const std::string& message) {
+            std::cerr << file << ":" << lineNumber << ": " << message << std::endl;
+            reported = true;
+            return false;
+        };
+        auto material = [&](uint32_t& index) {
+            std::string name;
+            if (!(fields >> name)) {
+                return false;
+            }
+            auto found = materialNames.find(name);
+            if (found == materialNames.end()) {
+                return fail("unknown material '" + name + "'");
+            }
+            index = found->second;
+            return true;
+        };
+
+        bool ok = true;
+        if (keyword == "background") {
+            ok = static_cast<bool>(fields >> scene.background);
+        } else if (keyword == "world") {
+            ok = static_cast<bool>(fields >> scene.world);
+        } else if (keyword == "light") {
+            if (hasLight) {
+                return fail("only one light is supported");
+            }
+            int r, g, b;
+            ok = static_cast<bool>(fields >> scene.light.position.x >> scene.light.position.y >> scene.light.position.z
+                                          >> scene.light.intensity >> r >> g >> b);
+            scene.light.color = Color(r, g, b);
+            hasLight = true;
+        } else if (keyword == "camera") {
+            CameraRecord& c = scene.camera;
+            ok = static_cast<bool>(fields >> c.position[0] >> c.position[1] >> c.position[2] >> c.target[0] >> c.target[1]
+                                          >> c.target[2] >> c.up[0] >> c.up[1] >> c.up[2] >> c.rotationSpeed);
+            scene.hasCamera = true;
+        } else if (keyword == "texture") {
+            std::string name, path;
+            ok = static_cast<bool>(fields >> name >> path);
+            if (ok && textureNames.count(name)) {
+                return fail("texture '" + name + "' already defined");
+            }
+            textureNames[name] = static_cast<int32_t>(scene.textures.size());
+            scene.textures.push_back(path);
+        } else if (keyword == "material") {
+            std::string name, texture;
+            int r, g, b;
+            MaterialRecord record = {};
+            ok = static_cast<bool>(fields >> name >> r >> g >> b >> record.albedo >> record.specularAlbedo
+                                          >> record.specularCoefficient >> record.reflectivity >> record.transparency
+                                          >> record.refractionIndex);
+            if (ok && materialNames.count(name)) {
+                return fail("material '" + name + "' already defined");
+            }
+            Color color(r, g, b);
+            record.color[0] = color.r;
+            record.color[1] = color.g;
+            record.color[2] = color.b;
+            record.color[3] = color.a;
+            record.texture = -1;
+            if (ok && fields >> texture) {
+                auto found = textureNames.find(texture);
+                if (found == textureNames.end()) {
+                    return fail("unknown texture '" + texture + "'");
+                }
+                record.texture = found->second;
+            }
+            materialNames[name] = static_cast<uint32_t>(scene.materials.size());
+            scene.materials.push_back(record);
+        } else if (keyword == "block") {
+            BlockRecord block;
+            ok = fields >> block.x >> block.y >> block.z && material(block.material);
+            scene.blocks.push_back(block);
+        } else if (keyword == "cube" || keyword == "sphere") {
+            ShapeRecord shape;
+            ok = fields >> shape.x >> shape.y >> shape.z >> shape.size && material(shape.material);
+            (keyword == "cube" ? scene.cubes : scene.spheres).push_back(shape);
+        } else {
+            return fail("unknown keyword '" + keyword + "'");
+        }
+        if (!ok) {
+            if (!reported) {
+                fail("malformed '" + keyword + "' line");
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readSceneFile(const std::string& file, SceneFile& scene) {
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        return false;
+    }
+    if (!isBinary(mapped)) {
+        mapped.close();
+        return readSceneText(file, scene);
+    }
+
+    SceneView view;
+    if (!parseBinary(file, mapped, view)) {
+        return false;
+    }
+    scene = SceneFile();
+    scene.background = view.background;
+    scene.world = view.world;
+    scene.textures = view.textures;
+    scene.materials.assign(view.materials.begin(), view.materials.end());
+    scene.light = view.light;
+    scene.hasCamera = view.hasCamera;
+    scene.camera = view.camera;
+    scene.blocks.assign(view.blocks.begin(), view.blocks.end());
+    scene.cubes.assign(view.cubes.begin(), view.cubes.end());
+    scene.spheres.assign(view.spheres.begin(), view.spheres.end());
+    return true;
+}
+
+bool writeSceneBinary(const std::string& file, const SceneFile& scene) {
+    std::ofstream out(file, std::ios::binary);
+    if (!out) {
+        std::cerr << "Cannot open " << file << " for writing" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> strings;
+    putString(strings, scene.background);
+    putString(strings, scene.world);
+    for (const std::string& texture : scene.textures) {
+        putString(strings, texture);
+    }
+
+    BinaryHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.hasCamera = scene.hasCamera ? 1 : 0;
+    header.lightPosition[0] = scene.light.position.x;
+    header.lightPosition[1] = scene.light.position.y;
+    header.lightPosition[2] = scene.light.position.z;
+    header.lightIntensity = scene.light.intensity;
+    header.lightColor[0] = scene.light.color.r;
+    header.lightColor[1] = scene.light.color.g;
+    header.lightColor[2] = scene.light.color.b;
+    header.lightColor[3] = scene.light.color.a;
+    header.camera = scene.camera;
+    header.textureCount = static_cast<uint32_t>(scene.textures.size());
+
+    // Primero se calculan las posiciones, despues se escribe todo en orden
+    auto place = [](uint64_t& offset, uint64_t bytes) {
+        offset = (offset + 7) & ~uint64_t(7);
+        uint64_t start = offset;
+        offset += bytes;
+        return start;
+    };
+    uint64_t offset = sizeof(BinaryHeader);
+    header.stringsOffset = place(offset, strings.size());
+    header.stringsSize = strings.size();
+    header.materialsOffset = place(offset, scene.materials.size() * sizeof(MaterialRecord));
+    header.materialCount = scene.materials.size();
+    header.blocksOffset = place(offset, scene.blocks.size() * sizeof(BlockRecord));
+    header.blockCount = scene.blocks.size();
+    header.cubesOffset = place(offset, scene.cubes.size() * sizeof(ShapeRecord));
+    header.cubeCount = scene.cubes.size();
+    header.spheresOffset = place(offset, scene.spheres.size() * sizeof(ShapeRecord));
+    header.sphereCount = scene.spheres.size();
+
+    offset = 0;
+    writeSection(out, offset, std::span<const BinaryHeader>(&header, 1));
+    pad(out, offset);
+    writeSection(out, offset, std::span<const uint8_t>(strings));
+    pad(out, offset);
+    writeSection(out, offset, std::span<const MaterialRecord>(scene.materials));
+    pad(out, offset);
+    writeSection(out, offset, std::span<const BlockRecord>(scene.blocks));
+    pad(out, offset);
+    writeSection(out, offset, std::span<const ShapeRecord>(scene.cubes));
+    pad(out, offset);
+    writeSection(out, offset, std::span<const ShapeRecord>(scene.spheres));
+
+    if (!out) {
+        std::cerr << "Failed writing " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool writeSceneWorld(const std::string& file, const SceneFile& scene) {
+    if (scene.blocks.empty()) {
+        std::cerr << "The scene has no blocks to write as a world" << std::endl;
+        return false;
+    }
+
+    // Los limites se validan antes de agrupar los bloques por chunk; cada chunk se escribe entero
+    // una sola vez
+    const int size = ChunkedWorld::CHUNK_SIZE;
+    auto cellOf = [](const BlockRecord& block) { return glm::ivec3(block.x, block.y, block.z); };
+    glm::ivec3 fromChunk = ChunkedWorld::chunkOf(cellOf(scene.blocks[0]));
+    glm::ivec3 toChunk = fromChunk;
+    for (const BlockRecord& block : scene.blocks) {
+        if (block.material >= scene.materials.size() || block.material + 1 > std::numeric_limits<MaterialId>::max()) {
+            std::cerr << "Block references missing material " << block.material << std::endl;
+            return false;
+        }
+        glm::ivec3 chunk = ChunkedWorld::chunkOf(cellOf(block));
+        fromChunk = glm::min(fromChunk, chunk);
+        toChunk = glm::max(toChunk, chunk);
+    }
+
+    ChunkedWorldWriter writer;
+    if (!writer.open(file, fromChunk, toChunk)) {
+        return false;
+    }
+    std::map<std::tuple<int, int, int>, std::vector<MaterialId>> chunks;
+    for (const BlockRecord& block : scene.blocks) {
+        glm::ivec3 chunk = ChunkedWorld::chunkOf(cellOf(block));
+        std::vector<MaterialId>& cells = chunks[{chunk.x, chunk.y, chunk.z}];
+        cells.resize(ChunkedWorld::CHUNK_CELLS);
+        glm::ivec3 local = cellOf(block) - chunk * size;
+        cells[(local.z * size + local.y) * size + local.x] = static_cast<MaterialId>(block.material + 1);
+    }
+    for (const auto& [key, cells] : chunks) {
+        if (!writer.add(glm::ivec3(std::get<0>(key), std::get<1>(key), std::get<2>(key)), cells.data())) {
+            return false;
+        }
+    }
+    return writer.close();
+}
+
+void rebaseScenePaths(SceneFile& scene, const std::string& from, const std::string& to) {
+    std::filesystem::path target = std::filesystem::absolute(std::filesystem::path(to)).parent_path();
+    auto rebase = [&](std::string& path) {
+        if (!path.empty() && !std::filesystem::path(path).is_absolute()) {
+            std::filesystem::path source = std::filesystem::absolute(resolvePath(from, path));
+            path = source.lexically_normal().lexically_relative(target.lexically_normal()).generic_string();
+        }
+    };
+    rebase(scene.background);
+    rebase(scene.world);
+    for (std::string& texture : scene.textures) {
+        rebase(texture);
+    }
+}
+
+bool loadScene(const std::string& file, Scene& scene, Camera& camera) {
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        return false;
+    }
+    if (isBinary(mapped)) {
+        SceneView view;
+        return parseBinary(file, mapped, view) && instantiate(file, view, scene, camera);
+    }
+    mapped.close();
+
+    SceneFile text;
+    return readSceneText(file, text) && instantiate(file, viewOf(text), scene, camera);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "camera.h"
+#include "light.h"
+#include "scene.h"
+
+// Escenas en archivo, en dos formas con el mismo contenido:
+//
+// Texto (.scene), una declaracion por linea; '#' empieza un comentario. Los nombres de
+// textura y material se declaran antes de usarse y las rutas son relativas al archivo.
+//   background <archivo>
+//   world <archivo>                         mundo por chunks en disco (.world) como malla
+//   light <x> <y> <z> <intensidad> <r> <g> <b>
+//   camera <px> <py> <pz> <tx> <ty> <tz> <ux> <uy> <uz> <velocidad de rotacion>
+//   texture <nombre> <archivo>
+//   material <nombre> <r> <g> <b> <albedo> <albedo especular> <coef. especular>
+//            <reflectividad> <transparencia> <indice de refraccion> [textura]
+//   block <x> <y> <z> <material>            cubo unitario en una celda de la malla
+//   cube <x> <y> <z> <tamaño> <material>
+//   sphere <x> <y> <z> <radio> <material>
+//
+// Binaria (.sceneb): cabecera SceneBinaryHeader y secciones de registros de tamaño fijo,
+// little-endian y alineadas a 8 bytes, para leer los bloques directo del archivo proyectado.
+
+// Registros de las secciones binarias; los indices de material y textura son posiciones
+// en SceneFile::materials y SceneFile::textures
+struct MaterialRecord {
+    uint8_t color[4];
+    float albedo;
+    float specularAlbedo;
+    float specularCoefficient;
+    float reflectivity;
+    float transparency;
+    float refractionIndex;
+    int32_t texture;  // -1 = sin textura
+};
+
+struct BlockRecord {
+    int32_t x, y, z;
+    uint32_t material;
+};
+
+// Cubo o esfera: centro y tamaño o radio
+struct ShapeRecord {
+    float x, y, z;
+    float size;
+    uint32_t material;
+};
+
+struct CameraRecord {
+    float position[3];
+    float target[3];
+    float up[3];
+    float rotationSpeed;
+};
+
+// Contenido de un archivo de escena antes de armarlo en una Scene
+struct SceneFile {
+    std::string background;
+    std::string world;
+    std::vector<std::string> textures;
+    std::vector<MaterialRecord> materials;
+    Light light = {glm::vec3(-10.0, 0, 10), 1.0f, Color(255, 255, 255)};
+    bool hasCamera = false;
+    CameraRecord camera = {};
+    std::vector<BlockRecord> blocks;
+    std::vector<ShapeRecord> cubes;
+    std::vector<ShapeRecord> spheres;
+};
+
+// Lee cualquiera de las dos formas (la binaria se reconoce por su firma). Las rutas de
+// 'background', 'world' y 'textures' quedan como estan escritas.
+bool readSceneFile(const std::string& file, SceneFile& scene);
+bool readSceneText(const std::string& file, SceneFile& scene);
+bool writeSceneBinary(const std::string& file, const SceneFile& scene);
+// Escribe los bloques como un mundo por chunks; cada celda guarda el indice de su material mas 1
+bool writeSceneWorld(const std::string& file, const SceneFile& scene);
+// Reescribe las rutas relativas leidas del archivo 'from' para que valgan desde el archivo 'to'
+void rebaseScenePaths(SceneFile& scene, const std::string& from, const std::string& to);
+
+// Arma el archivo en 'scene' sin llamar build(): materiales, texturas y fondo, luz, bloques
+// directo en la malla y cubos/esferas en 'objects'. 'camera' cambia solo si el archivo trae una.
+// La forma binaria se proyecta en memoria y los bloques se leen de ahi sin copiarlos. Con
+// 'world' la malla pasa a ser ese mundo y los bloques sueltos se agregan como cubos.
+bool loadScene(const std::string& file, Scene& scene, Camera& camera);
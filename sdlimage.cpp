@@ -0,0 +1,49 @@
+#include "sdlimage.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cstring>
+#include <iostream>
+
+bool decodeImageSDL(const std::string& file, ImageData& image) {
+    SDL_Surface* loaded = IMG_Load(file.c_str());
+    if (loaded == nullptr) {
+        std::cerr << "Unable to load image: " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // Cualquier formato (incluidas paletas) pasa a RGBA8 una sola vez
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (rgba == nullptr) {
+        std::cerr << "Unable to convert image! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    image.width = rgba->w;
+    image.height = rgba->h;
+    image.rgba.resize(static_cast<size_t>(rgba->w) * rgba->h * 4);
+    SDL_LockSurface(rgba);
+    for (int y = 0; y < rgba->h; y++) {
+        std::memcpy(&image.rgba[static_cast<size_t>(y) * rgba->w * 4],
+                    static_cast<uint8_t*>(rgba->pixels) + static_cast<size_t>(y) * rgba->pitch,
+                    static_cast<size_t>(rgba->w) * 4);
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+    return true;
+}
+
+bool encodePNGSDL(const std::string& file, const ImageData& image) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint8_t*>(image.rgba.data()), image.width,
+                                                              image.height, 32, image.width * 4, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr) {
+        std::cerr << "Unable to create surface! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    bool ok = IMG_SavePNG(surface, file.c_str()) == 0;
+    if (!ok) {
+        std::cerr << "Unable to save image: " << IMG_GetError() << std::endl;
+    }
+    SDL_FreeSurface(surface);
+    return ok;
+}
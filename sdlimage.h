@@ -0,0 +1,8 @@
+#pragma once
+
+#include "image.h"
+
+// Decodificador y codificador PNG con SDL_image para los frontends. No necesitan
+// SDL_Init ni una ventana, asi que sirven tambien para el render sin ventana.
+bool decodeImageSDL(const std::string& file, ImageData& image);
+bool encodePNGSDL(const std::string& file, const ImageData& image);
@@ -0,0 +1,57 @@
+#include "sdlview.h"
+#include <cstring>
+#include <iostream>
+
+SDLTextureView::~SDLTextureView() {
+    destroy();
+}
+
+bool SDLTextureView::create(SDL_Renderer* renderer, int width, int height, bool streaming, bool blend) {
+    destroy();
+    this->width = width;
+    this->height = height;
+    this->streaming = streaming;
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                streaming ? SDL_TEXTUREACCESS_STREAMING : SDL_TEXTUREACCESS_STATIC, width, height);
+    if (texture == nullptr) {
+        std::cerr << "Unable to create texture! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    return true;
+}
+
+void SDLTextureView::upload(const uint8_t* rgba) {
+    if (texture == nullptr) {
+        return;
+    }
+
+    if (!streaming) {
+        SDL_UpdateTexture(texture, nullptr, rgba, width * 4);
+        return;
+    }
+
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0) {
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (int y = 0; y < height; y++) {
+            std::memcpy(static_cast<uint8_t*>(pixels) + static_cast<size_t>(y) * pitch, rgba + y * rowBytes, rowBytes);
+        }
+        SDL_UnlockTexture(texture);
+    }
+}
+
+void SDLTextureView::draw(SDL_Renderer* renderer) const {
+    if (texture != nullptr) {
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    }
+}
+
+void SDLTextureView::destroy() {
+    if (texture != nullptr) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+
+// Textura de SDL que refleja un buffer RGBA8 de CPU. Con streaming = true se
+// actualiza con SDL_LockTexture cada cuadro; si no, se sube una vez.
+class SDLTextureView {
+public:
+    ~SDLTextureView();
+
+    bool create(SDL_Renderer* renderer, int width, int height, bool streaming, bool blend);
+    void upload(const uint8_t* rgba);
+    // Dibuja la textura estirada sobre toda la ventana
+    void draw(SDL_Renderer* renderer) const;
+    // Hay que llamarlo antes de destruir el renderer
+    void destroy();
+
+private:
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+    bool streaming = false;
+};
@@ -1,30 +1,17 @@
 #include "sphere.h"
 
-Sphere::Sphere(const glm::vec3& center, float radius, const Material& mat)
+Sphere::Sphere(const glm::vec3& center, float radius, MaterialId mat)
   : center(center), radius(radius), Object(mat) {}
 
-Intersect Sphere::rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const {
-  glm::vec3 oc = rayOrigin - center;
-
-  float a = glm::dot(rayDirection, rayDirection);
-  float b = 2.0f * glm::dot(oc, rayDirection);
-  float c = glm::dot(oc, oc) - radius * radius;
-
-  float discriminant = b * b - 4 * a * c;
-
-  if (discriminant < 0) {
-    return Intersect{false};
-  }
-
-  float dist = (-b - sqrt(discriminant)) / (2.0f * a);
-
-  if (dist < 0) {
-    return Intersect{false};
-  }
-
-  glm::vec3 point = rayOrigin + dist * rayDirection;
-  glm::vec3 normal = glm::normalize(point - center);
-  return Intersect{true, dist, point, normal};
+bool Sphere::rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const {
+  return distance(center, radius, rayOrigin, rayDirection, t);
 }
 
+Intersect Sphere::surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const {
+  return surface(center, rayOrigin, rayDirection, t);
+}
 
+AABB Sphere::getBounds() const {
+  glm::vec3 extent(radius);
+  return AABB{center - extent, center + extent};
+}
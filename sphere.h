@@ -7,9 +7,41 @@
 
 class Sphere : public Object {
 public:
-  Sphere(const glm::vec3& center, float radius, const Material& mat);
+  Sphere(const glm::vec3& center, float radius, MaterialId mat);
 
-  Intersect rayIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection) const override;
+  bool rayDistance(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) const override;
+
+  Intersect surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) const override;
+
+  AABB getBounds() const override;
+
+  const glm::vec3& getCenter() const { return center; }
+  float getRadius() const { return radius; }
+
+  // Prueba y superficie de una esfera dada por centro y radio, sin objeto.
+  // Las usan rayDistance/surfaceAt y los arreglos de esferas compilados de Scene.
+  static bool distance(const glm::vec3& center, float radius, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& t) {
+    glm::vec3 oc = rayOrigin - center;
+
+    float a = glm::dot(rayDirection, rayDirection);
+    float b = 2.0f * glm::dot(oc, rayDirection);
+    float c = glm::dot(oc, oc) - radius * radius;
+
+    float discriminant = b * b - 4 * a * c;
+
+    if (discriminant < 0) {
+      return false;
+    }
+
+    t = (-b - sqrt(discriminant)) / (2.0f * a);
+    return t >= 0;
+  }
+
+  static Intersect surface(const glm::vec3& center, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) {
+    glm::vec3 point = rayOrigin + t * rayDirection;
+    glm::vec3 normal = glm::normalize(point - center);
+    return Intersect{true, t, point, normal};
+  }
 
 private:
   glm::vec3 center;
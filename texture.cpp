@@ -0,0 +1,59 @@
+#include "texture.h"
+
+namespace {
+    int nextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    int log2(int value) {
+        int result = 0;
+        while ((1 << result) < value) {
+            result++;
+        }
+        return result;
+    }
+}
+
+const Texture* TextureStore::add(int width, int height, const uint8_t* rgba) {
+    auto texture = std::make_unique<Texture>();
+    texture->width = nextPowerOfTwo(width);
+    texture->height = nextPowerOfTwo(height);
+    texture->maskX = static_cast<uint32_t>(texture->width - 1);
+    texture->maskY = static_cast<uint32_t>(texture->height - 1);
+    texture->shiftX = log2(texture->width);
+    texture->texels.resize(static_cast<size_t>(texture->width) * texture->height);
+
+    // Vecino mas cercano: cada texel original se repite, no se mezcla
+    for (int y = 0; y < texture->height; y++) {
+        int srcY = static_cast<int>(static_cast<long long>(y) * height / texture->height);
+        for (int x = 0; x < texture->width; x++) {
+            int srcX = static_cast<int>(static_cast<long long>(x) * width / texture->width);
+            const uint8_t* p = rgba + (static_cast<size_t>(srcY) * width + srcX) * 4;
+            texture->texels[static_cast<size_t>(y) * texture->width + x] =
+                    uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+        }
+    }
+
+    textures.push_back(std::move(texture));
+    return textures.back().get();
+}
+
+const Texture* TextureStore::load(const std::string& file) {
+    auto cached = byFile.find(file);
+    if (cached != byFile.end()) {
+        return cached->second;
+    }
+
+    ImageData image;
+    if (decoder == nullptr || !decoder(file, image)) {
+        return nullptr;
+    }
+
+    const Texture* texture = add(image.width, image.height, image.rgba.data());
+    byFile[file] = texture;
+    return texture;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "color.h"
+#include "image.h"
+
+// Textura ya decodificada: texeles RGBA8 empaquetados (r en el byte bajo) y
+// dimensiones potencia de dos para envolver las coordenadas con una mascara.
+struct Texture {
+    int width = 0;
+    int height = 0;
+    uint32_t maskX = 0;
+    uint32_t maskY = 0;
+    int shiftX = 0;  // log2(width)
+    std::vector<uint32_t> texels;
+
+    uint32_t fetch(uint32_t x, uint32_t y) const {
+        return texels[((y & maskY) << shiftX) | (x & maskX)];
+    }
+
+    // Mismo mapeo que usaba getColorFromSurface: u y v se intercambian para girar 90 grados
+    Color sample(float u, float v) const {
+        if (u < 0) u += 1.0f;
+        if (v < 0) v += 1.0f;
+
+        uint32_t x = static_cast<uint32_t>(static_cast<int>(v * width));
+        uint32_t y = static_cast<uint32_t>(static_cast<int>((1.0f - u) * height));
+        uint32_t texel = fetch(x, y);
+
+        Color color;
+        color.r = static_cast<uint8_t>(texel);
+        color.g = static_cast<uint8_t>(texel >> 8);
+        color.b = static_cast<uint8_t>(texel >> 16);
+        color.a = static_cast<uint8_t>(texel >> 24);
+        return color;
+    }
+};
+
+// Guarda cada textura una sola vez, convertida a RGBA8 y redimensionada a potencia de dos
+class TextureStore {
+public:
+    explicit TextureStore(ImageDecoder decoder = nullptr) : decoder(decoder) {}
+
+    // Decodifica el archivo la primera vez; las siguientes devuelve la misma textura.
+    // Sin decodificador devuelve nullptr y el material usa su color difuso.
+    const Texture* load(const std::string& file);
+
+    // Agrega una textura a partir de texeles RGBA8 (4 bytes por texel, filas sin relleno)
+    const Texture* add(int width, int height, const uint8_t* rgba);
+
+    size_t size() const { return textures.size(); }
+
+private:
+    ImageDecoder decoder;
+    std::vector<std::unique_ptr<Texture>> textures;
+    std::unordered_map<std::string, const Texture*> byFile;
+};
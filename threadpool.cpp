@@ -0,0 +1,101 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(size_t taskCount, Task task) {
+    // Solo un lote a la vez: el anterior tiene que terminar antes de cambiar 'job'
+    wait();
+    if (taskCount == 0) {
+        return;
+    }
+
+    job = std::move(task);
+    pending = taskCount;
+    for (size_t i = 0; i < taskCount; ++i) {
+        Queue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation++;
+    }
+    wake.notify_all();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0; });
+}
+
+bool ThreadPool::popTask(unsigned index, size_t& task) {
+    {
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Cola propia vacia: roba la tarea mas antigua de otro hilo
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    unsigned long long seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        size_t task;
+        while (popTask(index, task)) {
+            job(task);
+            // Se anota antes de descontar la tarea: quien vea pending == 0 ya ve la hora
+            lastFinish.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+}
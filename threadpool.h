@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos persistente. Cada hilo tiene su propia cola de tareas: saca
+// trabajo del final de la suya y, cuando se vacia, roba del inicio de las demas.
+class ThreadPool {
+public:
+    using Task = std::function<void(size_t)>;
+
+    // threadCount = 0 usa std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Reparte las tareas [0, taskCount) y vuelve sin esperar
+    void submit(size_t taskCount, Task task);
+    // Bloquea hasta que terminan todas las tareas enviadas con submit()
+    void wait();
+    // Sin bloquear: si ya terminaron todas las tareas enviadas
+    bool idle() const { return pending == 0; }
+    // Cuando termino la ultima tarea del lote anterior; para medir lotes sin llamar a wait()
+    std::chrono::steady_clock::time_point finishedAt() const {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(lastFinish.load()));
+    }
+
+    void run(size_t taskCount, Task task) {
+        submit(taskCount, std::move(task));
+        wait();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void workerLoop(unsigned index);
+    bool popTask(unsigned index, size_t& task);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;
+    Task job;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::atomic<size_t> pending{0};
+    unsigned long long generation = 0;
+    std::atomic<std::chrono::steady_clock::rep> lastFinish{0};
+    bool stopping = false;
+};
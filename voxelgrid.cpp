@@ -0,0 +1,325 @@
+#include "voxelgrid.h"
+#include "aabb.h"
+#include <algorithm>
+#include <iostream>
+
+static_assert(VoxelGrid::CHUNK_SIZE == ChunkedWorld::CHUNK_SIZE, "world chunks must match the grid layout");
+
+namespace {
+    int floorDiv(int a, int b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    glm::ivec3 chunkOf(const glm::ivec3& cell) {
+        return glm::ivec3(floorDiv(cell.x, VoxelGrid::CHUNK_SIZE),
+                          floorDiv(cell.y, VoxelGrid::CHUNK_SIZE),
+                          floorDiv(cell.z, VoxelGrid::CHUNK_SIZE));
+    }
+
+    int localIndex(const glm::ivec3& cell, const glm::ivec3& chunk) {
+        glm::ivec3 local = cell - chunk * VoxelGrid::CHUNK_SIZE;
+        return (local.z * VoxelGrid::CHUNK_SIZE + local.y) * VoxelGrid::CHUNK_SIZE + local.x;
+    }
+
+    // Mismo calculo de normal y coordenadas de textura que Cube::surfaceAt con size = 1, sobre
+    // las celdas [minCell, maxCell]. La uv sale de la celda de la caja que contiene el punto.
+    Intersect boxIntersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tHit,
+                           const glm::ivec3& minCell, const glm::ivec3& maxCell) {
+        glm::vec3 point = rayOrigin + tHit * rayDirection;
+        glm::vec3 normal(0.0f);
+
+        for (int i = 0; i < 3; ++i) {
+            if (point[i] < minCell[i] - 0.5f + 0.001f) {
+                normal[i] = -1.0f;
+            } else if (point[i] > maxCell[i] + 0.5f - 0.001f) {
+                normal[i] = 1.0f;
+            }
+        }
+
+        glm::vec3 center = glm::clamp(glm::floor(point + 0.5f), glm::vec3(minCell), glm::vec3(maxCell));
+        glm::vec3 local = point - center;
+        float tx, ty;
+        if (std::abs(normal.x) > 0) {
+            tx = local.z + 0.5f;
+            ty = local.y + 0.5f;
+        } else if (std::abs(normal.y) > 0) {
+            tx = local.x + 0.5f;
+            ty = local.z + 0.5f;
+        } else {
+            tx = local.x + 0.5f;
+            ty = local.y + 0.5f;
+        }
+
+        return Intersect{true, tHit, point, normal, tx, ty};
+    }
+}
+
+const MaterialId* VoxelGrid::cellsAt(const glm::ivec3& chunk) const {
+    if (world) {
+        return world->find(chunk);
+    }
+    auto found = chunks.find(chunk);
+    return found != chunks.end() ? found->second->cells : nullptr;
+}
+
+void VoxelGrid::set(const glm::ivec3& cell, MaterialId id) {
+    if (world) {
+        return;
+    }
+    glm::ivec3 chunk = chunkOf(cell);
+    auto found = chunks.find(chunk);
+    if (found == chunks.end()) {
+        if (id == 0) {
+            return;
+        }
+        found = chunks.emplace(chunk, std::make_unique<Chunk>()).first;
+    }
+
+    MaterialId& value = found->second->cells[localIndex(cell, chunk)];
+    if (value == 0 && id != 0) {
+        solidCount++;
+    } else if (value != 0 && id == 0) {
+        solidCount--;
+    }
+    value = id;
+
+    // Los limites solo crecen; las celdas vacias dentro de ellos no cambian el resultado
+    if (id != 0) {
+        minCell = glm::min(minCell, cell);
+        maxCell = glm::max(maxCell, cell);
+    }
+}
+
+bool VoxelGrid::stream(const std::string& file, const std::vector<MaterialId>& materials) {
+    if (materials.empty()) {
+        std::cerr << file << ": a world needs at least one material" << std::endl;
+        return false;
+    }
+    auto opened = std::make_unique<ChunkedWorld>();
+    if (!opened->open(file)) {
+        return false;
+    }
+
+    world = std::move(opened);
+    worldMaterials.assign(size_t(std::numeric_limits<MaterialId>::max()) + 1, materials[0]);
+    worldMaterials[0] = NO_MATERIAL;
+    for (size_t i = 0; i < materials.size() && i + 1 < worldMaterials.size(); i++) {
+        worldMaterials[i + 1] = materials[i];
+    }
+    chunks.clear();
+    minCell = world->getMinCell();
+    maxCell = world->getMaxCell();
+    solidCount = world->getSolidCount();
+    return true;
+}
+
+MaterialId VoxelGrid::get(const glm::ivec3& cell) const {
+    glm::ivec3 chunk = chunkOf(cell);
+    const MaterialId* cells = cellsAt(chunk);
+    return cells ? resolve(cells[localIndex(cell, chunk)]) : 0;
+}
+
+bool VoxelGrid::intersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMin, float tMax, VoxelHit& hit,
+                          const glm::ivec3* skip) const {
+    if (solidCount == 0) {
+        return false;
+    }
+
+    // Recorta el rayo contra la caja de celdas ocupadas
+    AABB box{glm::vec3(minCell) - 0.5f, glm::vec3(maxCell) + 0.5f};
+    glm::vec3 invDir = 1.0f / rayDirection;
+    float tEnter = box.rayEntry(rayOrigin, invDir, tMax);
+    if (tEnter == std::numeric_limits<float>::infinity()) {
+        return false;
+    }
+    glm::vec3 t0 = (box.min - rayOrigin) * invDir;
+    glm::vec3 t1 = (box.max - rayOrigin) * invDir;
+    glm::vec3 tBig = glm::max(t0, t1);
+    float tExit = glm::min(glm::min(tBig.x, tBig.y), glm::min(tBig.z, tMax));
+
+    // En este espacio la celda i ocupa [i, i + 1)
+    glm::vec3 shifted = rayOrigin + 0.5f;
+    glm::ivec3 cell = glm::clamp(glm::ivec3(glm::floor(shifted + rayDirection * tEnter)), minCell, maxCell);
+
+    glm::ivec3 step;
+    glm::vec3 tNext;
+    glm::vec3 tDelta;
+    for (int i = 0; i < 3; ++i) {
+        if (rayDirection[i] > 0.0f) {
+            step[i] = 1;
+            tNext[i] = (static_cast<float>(cell[i] + 1) - shifted[i]) * invDir[i];
+            tDelta[i] = invDir[i];
+        } else if (rayDirection[i] < 0.0f) {
+            step[i] = -1;
+            tNext[i] = (static_cast<float>(cell[i]) - shifted[i]) * invDir[i];
+            tDelta[i] = -invDir[i];
+        } else {
+            step[i] = 0;
+            tNext[i] = std::numeric_limits<float>::infinity();
+            tDelta[i] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    // Cache del chunk actual para no buscarlo en cada paso
+    glm::ivec3 currentChunk = chunkOf(cell);
+    const MaterialId* cells = cellsAt(currentChunk);
+    float t = tEnter;
+
+    while (true) {
+        int axis = (tNext.x < tNext.y) ? (tNext.x < tNext.z ? 0 : 2) : (tNext.y < tNext.z ? 1 : 2);
+
+        if (cells != nullptr) {
+            MaterialId id = cells[localIndex(cell, currentChunk)];
+            if (id != 0 && !(skip != nullptr && *skip == cell)) {
+                // Si el rayo empieza dentro de la celda, Cube::rayDistance reporta la salida
+                float tHit = (t > 0.0f) ? t : tNext[axis];
+                if (tHit >= tMin && tHit <= tMax) {
+                    hit.t = tHit;
+                    hit.cell = cell;
+                    hit.materialId = resolve(id);
+                    return true;
+                }
+            }
+        }
+
+        t = tNext[axis];
+        if (t > tExit) {
+            return false;
+        }
+        cell[axis] += step[axis];
+        tNext[axis] += tDelta[axis];
+
+        glm::ivec3 nextChunk = chunkOf(cell);
+        if (nextChunk != currentChunk) {
+            currentChunk = nextChunk;
+            cells = cellsAt(currentChunk);
+        }
+    }
+}
+
+bool VoxelGrid::occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMin, float tMax, float& t,
+                         const glm::ivec3* skip) const {
+    VoxelHit hit;
+    if (!intersect(rayOrigin, rayDirection, tMin, tMax, hit, skip)) {
+        return false;
+    }
+    t = hit.t;
+    return true;
+}
+
+Intersect VoxelGrid::surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const VoxelHit& hit) const {
+    return boxIntersect(rayOrigin, rayDirection, hit.t, hit.cell, hit.cell);
+}
+
+Intersect VoxelGrid::blockSurface(const BlockBox& box, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t) {
+    return boxIntersect(rayOrigin, rayDirection, t, box.min, box.max);
+}
+
+std::vector<BlockBox> VoxelGrid::mergeBlocks(const MaterialTable& materials) const {
+    std::vector<BlockBox> boxes;
+    if (world || solidCount == 0) {
+        return boxes;
+    }
+
+    std::vector<bool> opaque(materials.size() + 1, false);
+    for (size_t id = 1; id <= materials.size(); id++) {
+        opaque[id] = materials[static_cast<MaterialId>(id)].transparency <= 0.0f;
+    }
+
+    // Estado de cada celda en el chunk que se esta compilando. Las celdas visibles se marcan
+    // como usadas (EMPTY) al entrar en una caja; las tapadas se pueden compartir.
+    enum State : uint8_t { EMPTY, VISIBLE, HIDDEN, SINGLE };
+    State states[CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE];
+    auto indexOf = [](int x, int y, int z) { return (z * CHUNK_SIZE + y) * CHUNK_SIZE + x; };
+    const glm::ivec3 faces[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+    // En orden z, y, x para que las cajas no dependan del orden de la tabla
+    std::vector<glm::ivec3> keys;
+    keys.reserve(chunks.size());
+    for (const auto& entry : chunks) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end(), [](const glm::ivec3& a, const glm::ivec3& b) {
+        return a.z != b.z ? a.z < b.z : a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+
+    // Las cajas no salen de su chunk: cajas mas chicas y locales dan un BVH que descarta mejor
+    for (const glm::ivec3& chunk : keys) {
+        const MaterialId* cells = chunks.at(chunk)->cells;
+        glm::ivec3 base = chunk * CHUNK_SIZE;
+
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                for (int x = 0; x < CHUNK_SIZE; x++) {
+                    MaterialId id = cells[indexOf(x, y, z)];
+                    if (id == 0) {
+                        states[indexOf(x, y, z)] = EMPTY;
+                        continue;
+                    }
+                    // Los vecinos dentro del chunk se leen directo; los de afuera, por la tabla
+                    bool hidden = true;
+                    for (const glm::ivec3& face : faces) {
+                        glm::ivec3 n = glm::ivec3(x, y, z) + face;
+                        bool inside = glm::all(glm::greaterThanEqual(n, glm::ivec3(0))) && glm::all(glm::lessThan(n, glm::ivec3(CHUNK_SIZE)));
+                        hidden = hidden && opaque[inside ? cells[indexOf(n.x, n.y, n.z)] : get(base + n)];
+                    }
+                    states[indexOf(x, y, z)] = hidden ? HIDDEN : opaque[id] ? VISIBLE : SINGLE;
+                }
+            }
+        }
+
+        // Celdas [from, to] que pueden entrar en una caja de material 'id'
+        auto fits = [&](const glm::ivec3& from, const glm::ivec3& to, MaterialId id) {
+            for (int z = from.z; z <= to.z; z++) {
+                for (int y = from.y; y <= to.y; y++) {
+                    for (int x = from.x; x <= to.x; x++) {
+                        State state = states[indexOf(x, y, z)];
+                        if (state != HIDDEN && !(state == VISIBLE && cells[indexOf(x, y, z)] == id)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        };
+
+        // Greedy en x, luego y, luego z desde cada celda visible que queda
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                for (int x = 0; x < CHUNK_SIZE; x++) {
+                    State state = states[indexOf(x, y, z)];
+                    if (state != VISIBLE && state != SINGLE) {
+                        continue;
+                    }
+                    MaterialId id = cells[indexOf(x, y, z)];
+                    glm::ivec3 start(x, y, z);
+                    glm::ivec3 end = start;
+                    if (state == VISIBLE) {
+                        while (end.x + 1 < CHUNK_SIZE && fits(glm::ivec3(end.x + 1, start.y, start.z), glm::ivec3(end.x + 1, end.y, end.z), id)) {
+                            end.x++;
+                        }
+                        while (end.y + 1 < CHUNK_SIZE && fits(glm::ivec3(start.x, end.y + 1, start.z), glm::ivec3(end.x, end.y + 1, end.z), id)) {
+                            end.y++;
+                        }
+                        while (end.z + 1 < CHUNK_SIZE && fits(glm::ivec3(start.x, start.y, end.z + 1), glm::ivec3(end.x, end.y, end.z + 1), id)) {
+                            end.z++;
+                        }
+                    }
+
+                    for (int bz = start.z; bz <= end.z; bz++) {
+                        for (int by = start.y; by <= end.y; by++) {
+                            for (int bx = start.x; bx <= end.x; bx++) {
+                                State& covered = states[indexOf(bx, by, bz)];
+                                if (covered != HIDDEN) {
+                                    covered = EMPTY;
+                                }
+                            }
+                        }
+                    }
+                    boxes.push_back({base + start, base + end, id});
+                }
+            }
+        }
+    }
+    return boxes;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "chunkedworld.h"
+#include "material.h"
+#include "intersect.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Resultado de recorrer la malla: la distancia y la celda/material que la produjo.
+// Normal y uv se piden aparte con VoxelGrid::surfaceAt cuando es el corte final.
+struct VoxelHit {
+    float t = 0.0f;
+    glm::ivec3 cell;
+    MaterialId materialId = NO_MATERIAL;
+};
+
+// Bloques del mismo material juntados en una caja: ocupa las celdas [min, max]
+struct BlockBox {
+    glm::ivec3 min;
+    glm::ivec3 max;
+    MaterialId materialId = NO_MATERIAL;
+};
+
+// Malla de voxeles por chunks de 16x16x16. Cada celda guarda el id del material en la
+// MaterialTable de la escena (NO_MATERIAL = vacio) y representa un cubo unitario centrado en sus coordenadas enteras,
+// igual que los Cube de tamaño 1 de setUp().
+// Con stream() las celdas salen de un ChunkedWorld proyectado en memoria en vez de la tabla propia.
+class VoxelGrid {
+public:
+    static const int CHUNK_SIZE = 16;
+
+    // Solo para mallas en memoria; con un mundo en disco no hace nada
+    void set(const glm::ivec3& cell, MaterialId id);
+    MaterialId get(const glm::ivec3& cell) const;
+
+    // Reemplaza el contenido por el mundo en disco 'file'. El valor v > 0 de una celda del mundo
+    // es el material 'materials[v - 1]'; los valores sin material usan materials[0].
+    bool stream(const std::string& file, const std::vector<MaterialId>& materials);
+    ChunkedWorld* getWorld() { return world.get(); }
+    bool isStreaming() const { return world != nullptr; }
+
+    bool empty() const { return solidCount == 0; }
+    size_t size() const { return solidCount; }
+
+    // Recorrido 3D-DDA (Amanatides-Woo); acepta cortes con tMin <= t <= tMax. La celda 'skip'
+    // se ignora, igual que castShadow ignora el objeto golpeado.
+    bool intersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMin, float tMax, VoxelHit& hit,
+                   const glm::ivec3* skip = nullptr) const;
+
+    // Consulta de oclusion con el mismo recorrido. 't' recibe la distancia.
+    bool occluded(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float tMin, float tMax, float& t,
+                  const glm::ivec3* skip = nullptr) const;
+
+    // Punto, normal y uv de un corte, igual que Cube::surfaceAt con size = 1
+    Intersect surfaceAt(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const VoxelHit& hit) const;
+
+    // Compila las celdas en cajas para un BVH. Descarta los bloques con las seis caras tapadas
+    // por bloques opacos y junta los vecinos del mismo material dentro de cada chunk; los
+    // bloques tapados cuentan como de cualquier material para que las cajas crezcan por dentro.
+    // Los materiales transparentes quedan como cajas de una celda. Solo para mallas en memoria.
+    std::vector<BlockBox> mergeBlocks(const MaterialTable& materials) const;
+
+    // Punto, normal y uv de un corte con una caja de mergeBlocks(): la uv se repite en cada
+    // celda, asi que la textura queda igual que con bloques sueltos
+    static Intersect blockSurface(const BlockBox& box, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float t);
+
+private:
+    struct Chunk {
+        MaterialId cells[CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE] = {};
+    };
+
+    struct ChunkHash {
+        size_t operator()(const glm::ivec3& chunk) const {
+            return (static_cast<size_t>(static_cast<uint32_t>(chunk.x)) * 73856093u) ^
+                   (static_cast<size_t>(static_cast<uint32_t>(chunk.y)) * 19349663u) ^
+                   (static_cast<size_t>(static_cast<uint32_t>(chunk.z)) * 83492791u);
+        }
+    };
+
+    // Celdas de un chunk, de la tabla propia o del mundo en disco
+    const MaterialId* cellsAt(const glm::ivec3& chunk) const;
+    MaterialId resolve(MaterialId value) const { return world ? worldMaterials[value] : value; }
+
+    // Solo los chunks con bloques: dos bloques muy lejanos no reservan el espacio entre ellos
+    std::unordered_map<glm::ivec3, std::unique_ptr<Chunk>, ChunkHash> chunks;
+    glm::ivec3 minCell = glm::ivec3(std::numeric_limits<int>::max());
+    glm::ivec3 maxCell = glm::ivec3(std::numeric_limits<int>::min());
+    size_t solidCount = 0;
+
+    std::unique_ptr<ChunkedWorld> world;
+    std::vector<MaterialId> worldMaterials;  // valor de celda del mundo -> id en la MaterialTable
+};